@@ -0,0 +1,164 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+typedef std::chrono::steady_clock Clock;
+
+static double TimeIterations(const BenchmarkSuite::Body& body, long long iterations) {
+    auto start = Clock::now();
+    for (long long i = 0; i < iterations; i++) {
+        body();
+    }
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void BenchmarkSuite::Add(const std::string& name, const std::vector<int>& counts, Setup setup) {
+    m_cases.push_back({name, counts, setup});
+}
+
+std::vector<BenchmarkResult> BenchmarkSuite::Run(const BenchmarkOptions& options, std::ostream& log) const {
+    std::vector<BenchmarkResult> results;
+    
+    for (const Case& benchmark : m_cases) {
+        for (int count : benchmark.counts) {
+            std::string name = benchmark.name + "/" + std::to_string(count);
+            if (!options.filter.empty() && name.find(options.filter) == std::string::npos) {
+                continue;
+            }
+            
+            Body body = benchmark.setup(count);
+            if (!body) {
+                log << "  " << name << ": skipped" << std::endl;
+                continue;
+            }
+            
+            // Warm up, then double the iteration count until one sample is long enough
+            body();
+            long long iterations = 1;
+            while (TimeIterations(body, iterations) < options.minSampleSeconds && iterations < (1LL << 40)) {
+                iterations *= 2;
+            }
+            
+            std::vector<double> samples;
+            for (int sample = 0; sample < options.samples; sample++) {
+                samples.push_back(TimeIterations(body, iterations) * 1e9 / iterations);
+            }
+            std::sort(samples.begin(), samples.end());
+            
+            BenchmarkResult result;
+            result.name = name;
+            result.count = count;
+            result.iterations = iterations;
+            result.medianNs = samples[samples.size() / 2];
+            result.minNs = samples.front();
+            result.nsPerItem = count > 0 ? result.medianNs / count : result.medianNs;
+            results.push_back(result);
+            
+            char line[160];
+            std::snprintf(line, sizeof(line), "  %-36s %14.1f ns %12.3f ns/item  (%lld iterations)",
+                          name.c_str(), result.medianNs, result.nsPerItem, iterations);
+            log << line << std::endl;
+        }
+    }
+    return results;
+}
+
+bool WriteBenchmarkJson(const std::string& path, const std::vector<BenchmarkResult>& results) {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    
+    // One result per line keeps LoadBenchmarkJson trivial and diffs readable
+    file << "{\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult& result = results[i];
+        char line[256];
+        std::snprintf(line, sizeof(line),
+                      "    {\"name\": \"%s\", \"count\": %d, \"iterations\": %lld, \"median_ns\": %.3f, "
+                      "\"min_ns\": %.3f, \"ns_per_item\": %.4f}%s\n",
+                      result.name.c_str(), result.count, result.iterations, result.medianNs,
+                      result.minNs, result.nsPerItem, i + 1 < results.size() ? "," : "");
+        file << line;
+    }
+    file << "  ]\n}\n";
+    return static_cast<bool>(file);
+}
+
+// Returns the text after "key": on the line, or nullptr
+static const char* FindField(const std::string& line, const char* key) {
+    std::string pattern = std::string("\"") + key + "\":";
+    size_t position = line.find(pattern);
+    if (position == std::string::npos) {
+        return nullptr;
+    }
+    position += pattern.size();
+    while (position < line.size() && line[position] == ' ') {
+        position++;
+    }
+    return line.c_str() + position;
+}
+
+bool LoadBenchmarkJson(const std::string& path, std::vector<BenchmarkResult>& results) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    
+    results.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        const char* name = FindField(line, "name");
+        const char* median = FindField(line, "median_ns");
+        if (!name || !median || *name != '"') {
+            continue;
+        }
+        
+        BenchmarkResult result = {};
+        const char* nameEnd = std::strchr(name + 1, '"');
+        if (!nameEnd) {
+            continue;
+        }
+        result.name.assign(name + 1, nameEnd);
+        result.medianNs = std::strtod(median, nullptr);
+        if (const char* count = FindField(line, "count")) result.count = std::atoi(count);
+        if (const char* iterations = FindField(line, "iterations")) result.iterations = std::atoll(iterations);
+        if (const char* minimum = FindField(line, "min_ns")) result.minNs = std::strtod(minimum, nullptr);
+        if (const char* perItem = FindField(line, "ns_per_item")) result.nsPerItem = std::strtod(perItem, nullptr);
+        results.push_back(result);
+    }
+    return true;
+}
+
+int CompareWithBaseline(const std::vector<BenchmarkResult>& results, const std::vector<BenchmarkResult>& baseline,
+                        double thresholdPercent, std::ostream& out) {
+    int regressions = 0;
+    
+    for (const BenchmarkResult& result : results) {
+        auto previous = std::find_if(baseline.begin(), baseline.end(),
+                                     [&result](const BenchmarkResult& other) { return other.name == result.name; });
+        char line[200];
+        if (previous == baseline.end() || previous->medianNs <= 0) {
+            std::snprintf(line, sizeof(line), "  %-36s %14.1f ns  (new)", result.name.c_str(), result.medianNs);
+            out << line << std::endl;
+            continue;
+        }
+        
+        double change = (result.medianNs - previous->medianNs) / previous->medianNs * 100.0;
+        const char* verdict = "";
+        if (change > thresholdPercent) {
+            verdict = "  REGRESSION";
+            regressions++;
+        } else if (change < -thresholdPercent) {
+            verdict = "  faster";
+        }
+        std::snprintf(line, sizeof(line), "  %-36s %14.1f ns -> %14.1f ns  %+7.1f%%%s", result.name.c_str(),
+                      previous->medianNs, result.medianNs, change, verdict);
+        out << line << std::endl;
+    }
+    return regressions;
+}
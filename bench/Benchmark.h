@@ -0,0 +1,76 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Minimal benchmark harness: each case is set up once per entity count and
+// its body is timed in repeated samples. Results can be written to JSON and
+// compared against a previous run to catch regressions.
+
+struct BenchmarkResult {
+    std::string name;      // "<case>/<count>"
+    int count;             // Entity count the case was set up with
+    long long iterations;  // Body calls per sample
+    double medianNs;       // Median time per body call over all samples
+    double minNs;          // Fastest sample
+    double nsPerItem;      // medianNs / count
+};
+
+struct BenchmarkOptions {
+    std::string filter;          // Only run cases whose name contains this
+    double minSampleSeconds;     // Calibrate iterations so one sample takes at least this long
+    int samples;
+    
+    BenchmarkOptions() : minSampleSeconds(0.05), samples(7) {}
+};
+
+class BenchmarkSuite {
+public:
+    typedef std::function<void()> Body;
+    typedef std::function<Body(int count)> Setup;
+    
+    // Setup builds the data for one entity count and returns the body to time
+    void Add(const std::string& name, const std::vector<int>& counts, Setup setup);
+    
+    std::vector<BenchmarkResult> Run(const BenchmarkOptions& options, std::ostream& log) const;
+    
+private:
+    struct Case {
+        std::string name;
+        std::vector<int> counts;
+        Setup setup;
+    };
+    
+    std::vector<Case> m_cases;
+};
+
+bool WriteBenchmarkJson(const std::string& path, const std::vector<BenchmarkResult>& results);
+bool LoadBenchmarkJson(const std::string& path, std::vector<BenchmarkResult>& results);
+
+// Prints the change of every result against the baseline and returns how many
+// got slower by more than thresholdPercent
+int CompareWithBaseline(const std::vector<BenchmarkResult>& results, const std::vector<BenchmarkResult>& baseline,
+                        double thresholdPercent, std::ostream& out);
+
+// Keep the compiler from optimizing away a value the benchmark computed
+template <typename T>
+inline void KeepAlive(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// Offscreen software renderer and font shared by the rendering benchmarks.
+// Either can be nullptr (no SDL, no font found); those cases are skipped.
+SDL_Renderer* GetBenchmarkRenderer();
+TTF_Font* GetBenchmarkFont();
+
+// Registration functions, one per benchmark file
+void RegisterMicroBenchmarks(BenchmarkSuite& suite);
+void RegisterSceneBenchmarks(BenchmarkSuite& suite);
@@ -0,0 +1,292 @@
+#include "Benchmark.h"
+#include "Types.h"
+#include "Player.h"
+#include "Enemy.h"
+#include "Coin.h"
+#include "SpatialGrid.h"
+#include "CollisionMap.h"
+#include "Platform.h"
+#include "Sweep.h"
+#include "ParticleSystem.h"
+#include "RenderQueue.h"
+#include "GlyphAtlas.h"
+#include <memory>
+#include <random>
+#include <string>
+
+static const float TICK = 1.0f / 60.0f;
+
+// Random rectangles scattered over one screen
+static std::vector<Rectangle> MakeRectangles(int count, unsigned seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> xDist(0, 1000);
+    std::uniform_real_distribution<float> yDist(0, 700);
+    std::uniform_real_distribution<float> sizeDist(10, 120);
+    
+    std::vector<Rectangle> rectangles;
+    for (int i = 0; i < count; i++) {
+        rectangles.push_back(Rectangle(xDist(random), yDist(random), sizeDist(random), sizeDist(random) * 0.3f));
+    }
+    return rectangles;
+}
+
+static void AddIntersectsBenchmark(BenchmarkSuite& suite) {
+    suite.Add("rect_intersects", {64, 1024, 16384}, [](int count) -> BenchmarkSuite::Body {
+        auto rectangles = std::make_shared<std::vector<Rectangle>>(MakeRectangles(count, 1));
+        Rectangle player(480, 330, 30, 40);
+        return [rectangles, player]() {
+            int hits = 0;
+            for (const Rectangle& rectangle : *rectangles) {
+                hits += player.Intersects(rectangle) ? 1 : 0;
+            }
+            KeepAlive(hits);
+        };
+    });
+}
+
+static void AddSweepBenchmark(BenchmarkSuite& suite) {
+    suite.Add("sweep_box", {64, 1024, 16384}, [](int count) -> BenchmarkSuite::Body {
+        auto rectangles = std::make_shared<std::vector<Rectangle>>(MakeRectangles(count, 1));
+        Rectangle player(480, 330, 30, 40);
+        Vector2 motion(120, 250);  // A fast diagonal fall over one long tick
+        return [rectangles, player, motion]() {
+            int hits = 0;
+            SweepHit hit;
+            for (const Rectangle& rectangle : *rectangles) {
+                hits += SweepBox(player, motion, rectangle, hit) ? 1 : 0;
+            }
+            KeepAlive(hits);
+        };
+    });
+}
+
+static void AddResolveCollisionBenchmark(BenchmarkSuite& suite) {
+    suite.Add("player_resolve_collision", {16, 256, 4096}, [](int count) -> BenchmarkSuite::Body {
+        // Platforms overlapping the player from every side, so all branches are taken
+        auto platforms = std::make_shared<std::vector<Rectangle>>();
+        std::mt19937 random(2);
+        std::uniform_real_distribution<float> offset(-35, 35);
+        for (int i = 0; i < count; i++) {
+            platforms->push_back(Rectangle(500 + offset(random), 350 + offset(random), 60, 20));
+        }
+        
+        Player prototype(500, 350);
+        PlayerInput input;
+        input.right = true;
+        prototype.HandleInput(input);
+        prototype.Update(TICK);
+        
+        return [platforms, prototype]() {
+            Player player = prototype;
+            for (const Rectangle& platform : *platforms) {
+                player.ResolveCollision(platform);
+            }
+            KeepAlive(player);
+        };
+    });
+}
+
+static void AddCoinAnimationBenchmark(BenchmarkSuite& suite) {
+    suite.Add("coin_animation", {1024, 16384, 65536}, [](int count) -> BenchmarkSuite::Body {
+        auto coins = std::make_shared<CoinStore>();
+        for (int i = 0; i < count; i++) {
+            coins->Add(static_cast<float>(i * 30), 400);
+        }
+        return [coins]() {
+            coins->Update(TICK);
+        };
+    });
+}
+
+static void AddEnemyUpdateBenchmark(BenchmarkSuite& suite) {
+    suite.Add("enemy_update", {16, 256, 4096}, [](int count) -> BenchmarkSuite::Body {
+        struct State {
+            std::vector<Rectangle> ledges;
+            PlatformStore platforms;
+            SpatialGrid grid;
+            CollisionMap ground;
+            EnemyStore enemies;
+        };
+        auto state = std::make_shared<State>();
+        
+        // Short ledges in rows so enemies keep hitting edges and turning around
+        int columns = 8;
+        int rows = (count + columns - 1) / columns;
+        for (int row = 0; row < rows; row++) {
+            for (int column = 0; column < columns; column++) {
+                state->ledges.push_back(Rectangle(20 + column * 120.0f, 100 + row * (560.0f / rows), 90, 10));
+            }
+        }
+        state->grid.Begin(Rectangle(0, 0, 1000, 700));
+        for (int i = 0; i < static_cast<int>(state->ledges.size()); i++) {
+            const Rectangle& ledge = state->ledges[i];
+            state->platforms.Add(ledge.x, ledge.y, ledge.width, ledge.height);
+            state->grid.Insert(i, ledge);
+        }
+        state->grid.Finish();
+        state->ground.Build(Rectangle(0, 0, 1000, 700), state->platforms, state->grid);
+        
+        state->enemies.Reserve(count);
+        for (int i = 0; i < count; i++) {
+            const Rectangle& ledge = state->ledges[i];
+            state->enemies.Add(ledge.x + 30, ledge.y - EnemyStore::HEIGHT);
+        }
+        
+        // Edge detection plus the ground contact the world would resolve afterwards
+        return [state, count]() {
+            state->enemies.Update(TICK, state->ground, 1000, Rectangle(0, 0, 1000, 700));
+            for (int i = 0; i < count; i++) {
+                state->enemies.ResolveCollision(i, state->ledges[i]);
+            }
+        };
+    });
+}
+
+// Particles that never expire, so every iteration processes the full count
+static void AddGroundProbeBenchmarks(BenchmarkSuite& suite) {
+    // The same probes against ever more platforms: the grid answers from the
+    // platforms sharing the probe's cell, the collision map mostly from one bit
+    struct State {
+        PlatformStore platforms;
+        SpatialGrid grid;
+        CollisionMap ground;
+        std::vector<Vector2> probes;
+    };
+    auto setUp = [](int count) {
+        auto state = std::make_shared<State>();
+        std::mt19937 random(3);
+        std::uniform_real_distribution<float> x(0, 960);
+        std::uniform_real_distribution<float> y(0, 680);
+        state->grid.Begin(Rectangle(0, 0, 1000, 700));
+        for (int i = 0; i < count; i++) {
+            state->platforms.Add(x(random), y(random), 40, 20);
+            state->grid.Insert(i, state->platforms.GetBounds(i));
+        }
+        state->grid.Finish();
+        state->ground.Build(Rectangle(0, 0, 1000, 700), state->platforms, state->grid);
+        for (int i = 0; i < 1024; i++) {
+            state->probes.push_back(Vector2(x(random), y(random)));
+        }
+        return state;
+    };
+    
+    suite.Add("ground_probe_grid", {16, 256, 4096}, [setUp](int count) -> BenchmarkSuite::Body {
+        auto state = setUp(count);
+        return [state]() {
+            int solid = 0;
+            for (const Vector2& probe : state->probes) {
+                solid += state->grid.AnyContains(probe);
+            }
+            KeepAlive(solid);
+        };
+    });
+    suite.Add("ground_probe_map", {16, 256, 4096}, [setUp](int count) -> BenchmarkSuite::Body {
+        auto state = setUp(count);
+        return [state]() {
+            int solid = 0;
+            for (const Vector2& probe : state->probes) {
+                solid += state->ground.IsSolid(probe);
+            }
+            KeepAlive(solid);
+        };
+    });
+}
+
+static void FillParticles(ParticleSystem& particles, int count) {
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> position(0, 1000);
+    std::uniform_real_distribution<float> velocity(-100, 100);
+    for (int i = 0; i < count; i++) {
+        particles.AddParticle(Particle(Vector2(position(random), position(random) * 0.7f),
+                                       Vector2(velocity(random), velocity(random)),
+                                       Color(255, 200, 0), 1e6f, 3.0f));
+    }
+}
+
+static void AddParticleBenchmarks(BenchmarkSuite& suite) {
+    suite.Add("particle_update", {256, 4096, 65536, 100000}, [](int count) -> BenchmarkSuite::Body {
+        auto particles = std::make_shared<ParticleSystem>(count);
+        FillParticles(*particles, count);
+        return [particles]() {
+            particles->Update(TICK);
+        };
+    });
+    
+    suite.Add("particle_render", {256, 4096, 65536}, [](int count) -> BenchmarkSuite::Body {
+        auto particles = std::make_shared<ParticleSystem>(count);
+        FillParticles(*particles, count);
+        auto queue = std::make_shared<RenderQueue>();
+        
+        // Recording only; submission is covered by the scene benchmarks
+        return [particles, queue]() {
+            particles->Render(*queue, 0.5f);
+            queue->Clear();
+        };
+    });
+    
+    // Every effect in turn, count bursts per run, into a pool that is emptied each time
+    suite.Add("particle_emit", {16, 256, 4096}, [](int count) -> BenchmarkSuite::Body {
+        auto particles = std::make_shared<ParticleSystem>(count * 25);
+        particles->Seed(1);
+        return [particles, count]() {
+            particles->Clear();
+            for (int i = 0; i < count; i++) {
+                Vector2 position(static_cast<float>(i % 1000), 300);
+                switch (i % 4) {
+                    case 0: particles->CreateExplosion(position); break;
+                    case 1: particles->CreateCoinEffect(position); break;
+                    case 2: particles->CreateJumpEffect(position); break;
+                    default: particles->CreatePowerUpEffect(position); break;
+                }
+            }
+            KeepAlive(particles->GetCount());
+        };
+    });
+}
+
+static void AddTextBenchmark(BenchmarkSuite& suite) {
+    // Same work as Game::RenderText: a shadow pass and a coloured pass per string
+    suite.Add("render_text", {1, 16, 256}, [](int count) -> BenchmarkSuite::Body {
+        SDL_Renderer* renderer = GetBenchmarkRenderer();
+        TTF_Font* font = GetBenchmarkFont();
+        if (!renderer || !font) {
+            return nullptr;
+        }
+        
+        struct State {
+            GlyphAtlas text;
+            RenderQueue queue;
+            std::vector<std::string> lines;
+        };
+        auto state = std::make_shared<State>();
+        if (!state->text.Build(renderer, font)) {
+            return nullptr;
+        }
+        for (int i = 0; i < count; i++) {
+            state->lines.push_back("Score: " + std::to_string(i * 150));
+        }
+        
+        return [state, renderer]() {
+            int y = 0;
+            state->queue.SetLayer(RenderLayer::TEXT);
+            for (const std::string& line : state->lines) {
+                state->queue.BeginItem();
+                state->text.DrawText(state->queue, line, 12, y + 2, {0, 0, 0, 255});
+                state->text.DrawText(state->queue, line, 10, y, {255, 255, 255, 255});
+                y = (y + 20) % 680;
+            }
+            state->queue.Submit(renderer);
+        };
+    });
+}
+
+void RegisterMicroBenchmarks(BenchmarkSuite& suite) {
+    AddIntersectsBenchmark(suite);
+    AddSweepBenchmark(suite);
+    AddResolveCollisionBenchmark(suite);
+    AddCoinAnimationBenchmark(suite);
+    AddEnemyUpdateBenchmark(suite);
+    AddGroundProbeBenchmarks(suite);
+    AddParticleBenchmarks(suite);
+    AddTextBenchmark(suite);
+}
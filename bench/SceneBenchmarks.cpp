@@ -0,0 +1,227 @@
+#include "Benchmark.h"
+#include "World.h"
+#include "ParticleSystem.h"
+#include "RenderQueue.h"
+#include "SpriteAtlas.h"
+#include "Background.h"
+#include "StaticLayer.h"
+#include "ScenarioGenerator.h"
+#include "LevelFile.h"
+#include "JobSystem.h"
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+// Scripted input: run right and jump periodically so collisions and pickups happen
+static PlayerInput ScriptedInput(long long tick) {
+    PlayerInput input;
+    input.right = (tick / 90) % 7 < 4;
+    input.left = (tick / 90) % 7 == 5;
+    input.jump = tick % 40 < 10;
+    input.jumpPressed = tick % 40 == 0;
+    return input;
+}
+
+struct SceneState {
+    World world;
+    RenderQueue queue;
+    SpriteAtlas sprites;
+    Background background;
+    StaticLayer staticLayer;
+    std::unique_ptr<LevelLayout> scenario;  // Restarted on game over when set
+    int level = 1;
+    long long tick = 0;
+    
+    void Restart() {
+        if (scenario) {
+            world.LoadScenario(*scenario);
+        } else {
+            world.Reset(level);
+        }
+    }
+    
+    void Step() {
+        world.Step(1.0f / 60.0f, ScriptedInput(tick++));
+        if (world.IsGameOver()) {
+            Restart();
+        }
+    }
+    
+    // The world render pass of Game::Render: background, entities, particles, submit
+    void Render(SDL_Renderer* renderer) {
+        float cameraX = world.GetCamera().GetInterpolatedX(0.5f);
+        background.Render(renderer, World::WIDTH, World::HEIGHT, world.GetLevel(), cameraX);
+        queue.SetOffset(static_cast<int>(cameraX), 0);
+        Rectangle view = world.GetCamera().GetInterpolatedView(0.5f);
+        staticLayer.Render(renderer, queue, world.GetPlatforms(), view, static_cast<int>(cameraX), world.GetLevelLoadCount());
+        world.GetMovingPlatforms().Render(queue, view, 0.5f);
+        world.GetCoins().Render(queue, sprites, view);
+        world.GetPowerUps().Render(queue, sprites, view);
+        world.GetEnemies().Render(queue, sprites, view, 0.5f);
+        world.GetPlayer()->Render(queue, sprites, 0.5f);
+        world.GetParticleSystem().Render(queue, 0.5f);
+        queue.Submit(renderer);
+    }
+};
+
+static std::shared_ptr<SceneState> MakeScene(SDL_Renderer* renderer) {
+    auto state = std::make_shared<SceneState>();
+    if (renderer) {
+        CoinStore::BakeSprites(state->sprites);
+        PowerUpStore::BakeSprites(state->sprites);
+        EnemyStore::BakeSprites(state->sprites);
+        Player::BakeSprites(state->sprites);
+        state->sprites.Build(renderer);
+    }
+    state->world.SetSeed(1);
+    return state;
+}
+
+// Full frames: one simulation tick plus the world render pass into the
+// offscreen renderer. Later built-in levels have more enemies, so the count
+// here is the level number.
+static void AddLevelBenchmark(BenchmarkSuite& suite) {
+    suite.Add("scene_frame", {1, 10, 50}, [](int level) -> BenchmarkSuite::Body {
+        SDL_Renderer* renderer = GetBenchmarkRenderer();
+        if (!renderer) {
+            return nullptr;
+        }
+        
+        auto state = MakeScene(renderer);
+        state->level = level;
+        state->Restart();
+        return [state, renderer]() {
+            state->Step();
+            state->Render(renderer);
+        };
+    });
+}
+
+// Generated scenarios with the built-in proportions at growing entity counts,
+// for plotting frame time against entity count. The update-only variant needs
+// no renderer.
+static void AddScalingBenchmarks(BenchmarkSuite& suite) {
+    const std::vector<int> entityCounts = {100, 1000, 10000, 100000};
+    
+    suite.Add("scenario_update", entityCounts, [](int entities) -> BenchmarkSuite::Body {
+        auto state = MakeScene(nullptr);
+        state->scenario = std::make_unique<LevelLayout>(
+            ScenarioGenerator::Generate(ScenarioParameters::ForEntityCount(entities)));
+        state->Restart();
+        return [state]() {
+            state->Step();
+        };
+    });
+    
+    suite.Add("scenario_frame", entityCounts, [](int entities) -> BenchmarkSuite::Body {
+        SDL_Renderer* renderer = GetBenchmarkRenderer();
+        if (!renderer) {
+            return nullptr;
+        }
+        
+        auto state = MakeScene(renderer);
+        state->scenario = std::make_unique<LevelLayout>(
+            ScenarioGenerator::Generate(ScenarioParameters::ForEntityCount(entities)));
+        state->Restart();
+        return [state, renderer]() {
+            state->Step();
+            state->Render(renderer);
+        };
+    });
+}
+
+// One tick of a scenario packed densely enough that thousands of entities
+// and particles are streamed in and awake at once, split across this many
+// threads (including the caller). Compare against the 1-thread case.
+static void AddThreadScalingBenchmark(BenchmarkSuite& suite) {
+    suite.Add("dense_update_threads", {1, 2, 4, 8, 16}, [](int threads) -> BenchmarkSuite::Body {
+        struct ThreadedScene {
+            JobSystem jobs;
+            std::shared_ptr<SceneState> scene;
+            explicit ThreadedScene(int workers) : jobs(workers), scene(MakeScene(nullptr)) {}
+        };
+        auto state = std::make_shared<ThreadedScene>(threads - 1);
+        ScenarioParameters parameters = ScenarioParameters::ForEntityCount(100000);
+        parameters.density = 40.0f;
+        state->scene->scenario = std::make_unique<LevelLayout>(ScenarioGenerator::Generate(parameters));
+        state->scene->world.SetJobSystem(&state->jobs);
+        state->scene->Restart();
+        return [state]() {
+            state->scene->Step();
+        };
+    });
+}
+
+// Map a compiled level file and load it into a world, as --level does. The
+// file is written once during setup and removed when the case is done.
+static void AddLevelFileBenchmark(BenchmarkSuite& suite) {
+    suite.Add("level_load", {100, 1000, 10000, 100000}, [](int entities) -> BenchmarkSuite::Body {
+        std::string path = (std::filesystem::temp_directory_path() / 
+                            ("mario_bench_" + std::to_string(entities) + ".mlvl")).string();
+        LevelLayout layout = ScenarioGenerator::Generate(ScenarioParameters::ForEntityCount(entities));
+        if (!LevelFile::Write(path, layout)) {
+            return nullptr;
+        }
+        
+        struct LoadState {
+            std::string path;
+            LevelFile file;
+            World world;
+            ~LoadState() { file.Close(); std::remove(path.c_str()); }
+        };
+        auto state = std::make_shared<LoadState>();
+        state->path = path;
+        return [state]() {
+            state->file.Open(state->path);
+            state->world.LoadLevel(state->file);
+            KeepAlive(state->world.GetPlatforms().Size());
+        };
+    });
+}
+
+// Save the complete state of a scenario mid-level, and restore it as a
+// restart does. Ticked for a while first so part of the level has streamed
+// through and particles are alive.
+static void AddStateBenchmarks(BenchmarkSuite& suite) {
+    const std::vector<int> entityCounts = {100, 1000, 10000, 100000};
+    
+    struct SavedScene {
+        std::shared_ptr<SceneState> scene;
+        std::vector<std::uint8_t> image;
+    };
+    auto setUp = [](int entities) {
+        auto state = std::make_shared<SavedScene>();
+        state->scene = MakeScene(nullptr);
+        state->scene->scenario = std::make_unique<LevelLayout>(
+            ScenarioGenerator::Generate(ScenarioParameters::ForEntityCount(entities)));
+        state->scene->Restart();
+        for (int tick = 0; tick < 600; tick++) {
+            state->scene->Step();
+        }
+        state->scene->world.SaveState(state->image);
+        return state;
+    };
+    
+    suite.Add("state_save", entityCounts, [setUp](int entities) -> BenchmarkSuite::Body {
+        auto state = setUp(entities);
+        return [state]() {
+            state->scene->world.SaveState(state->image);
+            KeepAlive(state->image.size());
+        };
+    });
+    suite.Add("state_restore", entityCounts, [setUp](int entities) -> BenchmarkSuite::Body {
+        auto state = setUp(entities);
+        return [state]() {
+            KeepAlive(state->scene->world.LoadState(state->image));
+        };
+    });
+}
+
+void RegisterSceneBenchmarks(BenchmarkSuite& suite) {
+    AddLevelBenchmark(suite);
+    AddScalingBenchmarks(suite);
+    AddThreadScalingBenchmark(suite);
+    AddLevelFileBenchmark(suite);
+    AddStateBenchmarks(suite);
+}
@@ -0,0 +1,128 @@
+#include "Benchmark.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+static SDL_Surface* s_surface = nullptr;
+static SDL_Renderer* s_renderer = nullptr;
+static TTF_Font* s_font = nullptr;
+
+SDL_Renderer* GetBenchmarkRenderer() {
+    return s_renderer;
+}
+
+TTF_Font* GetBenchmarkFont() {
+    return s_font;
+}
+
+// Render into a window-sized surface so rendering benchmarks need no display or GPU
+static void InitializeRendering() {
+    if (SDL_Init(0) < 0) {
+        std::cerr << "SDL could not initialize: " << SDL_GetError() << std::endl;
+        return;
+    }
+    
+    s_surface = SDL_CreateRGBSurfaceWithFormat(0, 1000, 700, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (s_surface) {
+        s_renderer = SDL_CreateSoftwareRenderer(s_surface);
+    }
+    if (!s_renderer) {
+        std::cerr << "Offscreen renderer unavailable, rendering benchmarks skipped: " << SDL_GetError() << std::endl;
+        return;
+    }
+    
+    const char* fontPaths[] = {
+        "assets/fonts/PressStart2P-Regular.ttf",
+        "/System/Library/Fonts/Helvetica.ttc",
+        "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+        "/usr/share/fonts/TTF/DejaVuSans.ttf",
+        "C:/Windows/Fonts/arial.ttf",
+        nullptr
+    };
+    if (TTF_Init() == 0) {
+        for (int i = 0; fontPaths[i] && !s_font; i++) {
+            s_font = TTF_OpenFont(fontPaths[i], 16);
+        }
+    }
+    if (!s_font) {
+        std::cerr << "No font found, text benchmarks skipped" << std::endl;
+    }
+}
+
+static void ShutdownRendering() {
+    if (s_font) {
+        TTF_CloseFont(s_font);
+        s_font = nullptr;
+    }
+    TTF_Quit();
+    
+    if (s_renderer) {
+        SDL_DestroyRenderer(s_renderer);
+        s_renderer = nullptr;
+    }
+    if (s_surface) {
+        SDL_FreeSurface(s_surface);
+        s_surface = nullptr;
+    }
+    SDL_Quit();
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    std::string outputPath = "bench_results.json";
+    std::string baselinePath;
+    double thresholdPercent = 10.0;
+    
+    // Command line: [--filter <text>] [--out <file>] [--baseline <file>] [--threshold <percent>] [--quick]
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--out" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "--baseline" && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (arg == "--threshold" && i + 1 < argc) {
+            thresholdPercent = std::atof(argv[++i]);
+        } else if (arg == "--quick") {
+            options.minSampleSeconds = 0.01;
+            options.samples = 3;
+        }
+    }
+    
+    // Load the baseline first so it can safely be the same file as the output
+    std::vector<BenchmarkResult> baseline;
+    if (!baselinePath.empty() && !LoadBenchmarkJson(baselinePath, baseline)) {
+        std::cerr << "Could not read baseline: " << baselinePath << std::endl;
+        return 2;
+    }
+    
+    InitializeRendering();
+    
+    BenchmarkSuite suite;
+    RegisterMicroBenchmarks(suite);
+    RegisterSceneBenchmarks(suite);
+    
+    std::cout << "Running benchmarks" << std::endl;
+    std::vector<BenchmarkResult> results = suite.Run(options, std::cout);
+    
+    ShutdownRendering();
+    
+    if (!WriteBenchmarkJson(outputPath, results)) {
+        std::cerr << "Could not write results to " << outputPath << std::endl;
+        return 2;
+    }
+    std::cout << "Wrote " << results.size() << " results to " << outputPath << std::endl;
+    
+    if (baselinePath.empty()) {
+        return 0;
+    }
+    
+    std::cout << std::endl << "Compared with " << baselinePath << " (threshold " << thresholdPercent << "%)" << std::endl;
+    int regressions = CompareWithBaseline(results, baseline, thresholdPercent, std::cout);
+    if (regressions > 0) {
+        std::cout << regressions << " benchmark(s) regressed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
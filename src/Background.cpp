@@ -0,0 +1,116 @@
+#include "Background.h"
+#include <cmath>
+
+Background::Background() 
+    : m_width(0), m_height(0), m_level(0), m_isValid(false), m_useTextures(false) {
+    // Back to front
+    m_layers.push_back({DrawSky, 0.0f, nullptr});
+    m_layers.push_back({DrawHills, 0.3f, nullptr});
+}
+
+Background::~Background() {
+    Destroy();
+}
+
+void Background::Destroy() {
+    for (Layer& layer : m_layers) {
+        if (layer.texture) {
+            SDL_DestroyTexture(layer.texture);
+            layer.texture = nullptr;
+        }
+    }
+    m_isValid = false;
+}
+
+void Background::Render(SDL_Renderer* renderer, int width, int height, int level, float cameraX) {
+    if (!m_isValid || width != m_width || height != m_height || level != m_level) {
+        Generate(renderer, width, height, level);
+    }
+    
+    for (const Layer& layer : m_layers) {
+        if (!m_useTextures) {
+            layer.draw(renderer, width, height, level);
+            continue;
+        }
+        
+        // Tile horizontally so the layer can scroll without running out
+        int offset = static_cast<int>(std::floor(cameraX * layer.parallax)) % width;
+        if (offset < 0) offset += width;
+        SDL_Rect first = {-offset, 0, width, height};
+        SDL_RenderCopy(renderer, layer.texture, nullptr, &first);
+        if (offset != 0) {
+            SDL_Rect second = {width - offset, 0, width, height};
+            SDL_RenderCopy(renderer, layer.texture, nullptr, &second);
+        }
+    }
+}
+
+void Background::Generate(SDL_Renderer* renderer, int width, int height, int level) {
+    Destroy();
+    m_width = width;
+    m_height = height;
+    m_level = level;
+    m_isValid = true;
+    m_useTextures = SDL_RenderTargetSupported(renderer) == SDL_TRUE;
+    
+    if (m_useTextures) {
+        for (Layer& layer : m_layers) {
+            layer.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+            if (!layer.texture || SDL_SetRenderTarget(renderer, layer.texture) != 0) {
+                m_useTextures = false;
+                break;
+            }
+            
+            // Start transparent so upper layers only cover what they draw
+            SDL_SetTextureBlendMode(layer.texture, SDL_BLENDMODE_BLEND);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+            SDL_RenderClear(renderer);
+            layer.draw(renderer, width, height, level);
+        }
+        SDL_SetRenderTarget(renderer, nullptr);
+    }
+    
+    if (!m_useTextures) {
+        // Keep the valid flag so we don't retry every frame; draw directly instead
+        for (Layer& layer : m_layers) {
+            if (layer.texture) {
+                SDL_DestroyTexture(layer.texture);
+                layer.texture = nullptr;
+            }
+        }
+    }
+}
+
+void Background::DrawSky(SDL_Renderer* renderer, int width, int height, int level) {
+    (void)level;
+    
+    // Sky blue, lightening towards the horizon in the upper half
+    SDL_SetRenderDrawColor(renderer, 135, 206, 235, 255);
+    SDL_Rect sky = {0, 0, width, height};
+    SDL_RenderFillRect(renderer, &sky);
+    
+    for (int y = 0; y < height/2; y++) {
+        Uint8 r = 135 + (120 * y) / (height/2);
+        Uint8 g = 206 + (49 * y) / (height/2);
+        Uint8 b = 235 + (20 * y) / (height/2);
+        SDL_SetRenderDrawColor(renderer, r, g, b, 255);
+        SDL_RenderDrawLine(renderer, 0, y, width, y);
+    }
+}
+
+void Background::DrawHills(SDL_Renderer* renderer, int width, int height, int level) {
+    // Distant rolling hills; their shape and tint change from level to level.
+    // Whole periods across the width so the layer tiles seamlessly.
+    const float twoPi = 2.0f * 3.14159265f;
+    float phase = level * 1.7f;
+    int baseY = height - height/4;
+    
+    Uint8 green = static_cast<Uint8>(190 + (level * 13) % 40);
+    SDL_SetRenderDrawColor(renderer, 150, green, 170, 255);
+    for (int x = 0; x < width; x++) {
+        float t = static_cast<float>(x) / width;
+        float wave = sin(t * twoPi * 2 + phase) * 30 + sin(t * twoPi * 5 + phase * 2.3f) * 12;
+        int top = baseY - 40 + static_cast<int>(wave);
+        SDL_RenderDrawLine(renderer, x, top, x, height);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+
+// Layered scenery behind the level. Each layer is drawn once into its own
+// texture and then copied to the screen every frame, so the background costs
+// one copy per layer instead of hundreds of primitives. Layers are
+// regenerated only when the output size or the level changes, or when the
+// renderer reports that its render targets were lost.
+//
+// Layers scroll at their own parallax factor relative to the camera and tile
+// horizontally. Without render-target support the layers are drawn directly
+// every frame instead.
+class Background {
+public:
+    Background();
+    ~Background();
+    
+    // Force a rebuild on the next Render (window resized, render targets reset)
+    void Invalidate() { m_isValid = false; }
+    void Destroy();
+    
+    void Render(SDL_Renderer* renderer, int width, int height, int level, float cameraX = 0.0f);
+    
+private:
+    typedef void (*DrawFunction)(SDL_Renderer* renderer, int width, int height, int level);
+    
+    struct Layer {
+        DrawFunction draw;
+        float parallax;     // 0 = fixed to the screen, 1 = moves with the world
+        SDL_Texture* texture;
+    };
+    
+    void Generate(SDL_Renderer* renderer, int width, int height, int level);
+    
+    static void DrawSky(SDL_Renderer* renderer, int width, int height, int level);
+    static void DrawHills(SDL_Renderer* renderer, int width, int height, int level);
+    
+    std::vector<Layer> m_layers;
+    int m_width;
+    int m_height;
+    int m_level;
+    bool m_isValid;
+    bool m_useTextures;
+};
\ No newline at end of file
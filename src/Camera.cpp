@@ -0,0 +1,32 @@
+#include "Camera.h"
+#include "StateStream.h"
+#include <algorithm>
+
+const float Camera::FOLLOW_POSITION = 0.4f;
+
+Camera::Camera(float viewWidth, float viewHeight)
+    : m_x(0.0f), m_previousX(0.0f), m_levelWidth(viewWidth), m_viewWidth(viewWidth), m_viewHeight(viewHeight) {
+}
+
+void Camera::Reset(float levelWidth) {
+    m_levelWidth = levelWidth;
+    m_x = 0.0f;
+    m_previousX = 0.0f;
+}
+
+void Camera::Follow(const Rectangle& target) {
+    float targetX = target.x + target.width / 2 - m_viewWidth * FOLLOW_POSITION;
+    float maxX = std::max(0.0f, m_levelWidth - m_viewWidth);
+    m_x = std::min(std::max(m_x, targetX), maxX);
+}
+
+void Camera::SaveState(StateWriter& out) const {
+    out.Write(m_x);
+    out.Write(m_previousX);
+}
+
+bool Camera::LoadState(StateReader& in) {
+    // Follow() keeps the view within the level
+    float maxX = std::max(0.0f, m_levelWidth - m_viewWidth);
+    return in.Read(m_x) && in.Read(m_previousX) && m_x >= 0.0f && m_x <= maxX && m_previousX >= 0.0f && m_previousX <= maxX;
+}
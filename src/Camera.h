@@ -0,0 +1,39 @@
+#pragma once
+#include "Types.h"
+
+class StateWriter;
+class StateReader;
+
+// Side-scrolling camera in world coordinates. It keeps the followed target
+// left of the middle of the view, only ever scrolls forward (the level is
+// streamed out behind it) and stops at the end of the level.
+class Camera {
+public:
+    Camera(float viewWidth, float viewHeight);
+    
+    // Back to the start of a level of this width
+    void Reset(float levelWidth);
+    void Follow(const Rectangle& target);
+    
+    // Remember the current position as the start of the next interpolation span
+    void StorePreviousState() { m_previousX = m_x; }
+    
+    float GetX() const { return m_x; }
+    float GetInterpolatedX(float alpha) const { return m_previousX + (m_x - m_previousX) * alpha; }
+    Rectangle GetView() const { return Rectangle(m_x, 0, m_viewWidth, m_viewHeight); }
+    Rectangle GetInterpolatedView(float alpha) const { return Rectangle(GetInterpolatedX(alpha), 0, m_viewWidth, m_viewHeight); }
+    
+    // Write the scroll position to a saved-state image, or read it back for
+    // the level the camera was last Reset() for (failing outside of it)
+    void SaveState(StateWriter& out) const;
+    bool LoadState(StateReader& in);
+    
+    static const float FOLLOW_POSITION;  // Fraction of the view width the target is kept at
+    
+private:
+    float m_x;
+    float m_previousX;
+    float m_levelWidth;
+    float m_viewWidth;
+    float m_viewHeight;
+};
\ No newline at end of file
@@ -1,65 +1,96 @@
 #include "Coin.h"
-#include <cmath>
+#include "StoreColumns.h"
+#include "FastTrig.h"
 
-const float Coin::ANIMATION_SPEED = 3.0f;
-const float Coin::FLOAT_AMPLITUDE = 5.0f;
+const float CoinStore::WIDTH = 20.0f;
+const float CoinStore::HEIGHT = 20.0f;
+const float CoinStore::ANIMATION_SPEED = 3.0f;
+const float CoinStore::FLOAT_AMPLITUDE = 5.0f;
 
-Coin::Coin(float x, float y) 
-    : m_position(x, y), m_width(20), m_height(20), m_isCollected(false), 
-      m_value(100), m_animationTimer(0.0f), m_floatOffset(0.0f) {
+CoinStore::CoinStore(LevelArena* arena) 
+    : m_x(arena), m_y(arena), m_floatOffset(arena), m_isCollected(arena), m_value(arena), 
+      m_animationTimer(arena), m_keep(arena) {
 }
 
-void Coin::Update(float deltaTime) {
-    if (m_isCollected) return;
-    
-    // Floating animation
-    m_animationTimer += deltaTime * ANIMATION_SPEED;
-    m_floatOffset = sin(m_animationTimer) * FLOAT_AMPLITUDE;
+void CoinStore::Clear() {
+    ReleaseColumn(m_x);
+    ReleaseColumn(m_y);
+    ReleaseColumn(m_floatOffset);
+    ReleaseColumn(m_isCollected);
+    ReleaseColumn(m_value);
+    ReleaseColumn(m_animationTimer);
+    ReleaseColumn(m_keep);
 }
 
-void Coin::Render(SDL_Renderer* renderer) {
-    if (m_isCollected) return;
-    
-    float renderY = m_position.y + m_floatOffset;
-    
-    // Draw coin as a yellow circle with shine effect
-    SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255); // Gold color
-    
-    // Draw multiple circles to create coin effect
-    int centerX = static_cast<int>(m_position.x + m_width/2);
-    int centerY = static_cast<int>(renderY + m_height/2);
-    int radius = static_cast<int>(m_width/2);
-    
-    // Draw filled circle (approximate)
-    for (int dy = -radius; dy <= radius; dy++) {
-        for (int dx = -radius; dx <= radius; dx++) {
-            if (dx*dx + dy*dy <= radius*radius) {
-                SDL_RenderDrawPoint(renderer, centerX + dx, centerY + dy);
-            }
-        }
-    }
+void CoinStore::Reserve(size_t count) {
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_floatOffset.reserve(count);
+    m_isCollected.reserve(count);
+    m_value.reserve(count);
+    m_animationTimer.reserve(count);
+    m_keep.reserve(count);
+}
+
+int CoinStore::Add(float x, float y) {
+    m_x.push_back(x);
+    m_y.push_back(y);
+    m_floatOffset.push_back(0.0f);
+    m_isCollected.push_back(0);
+    m_value.push_back(100);
+    m_animationTimer.push_back(0.0f);
+    return static_cast<int>(m_x.size()) - 1;
+}
+
+void CoinStore::AddRange(size_t count, const float* x, const float* y) {
+    m_x.insert(m_x.end(), x, x + count);
+    m_y.insert(m_y.end(), y, y + count);
+    m_floatOffset.insert(m_floatOffset.end(), count, 0.0f);
+    m_isCollected.insert(m_isCollected.end(), count, 0);
+    m_value.insert(m_value.end(), count, 100);
+    m_animationTimer.insert(m_animationTimer.end(), count, 0.0f);
+}
+
+size_t CoinStore::RemoveLeftOf(float x) {
+    size_t removed = MarkLeftOf(m_x, WIDTH, x, m_keep);
+    if (removed == 0) return 0;
     
-    // Add shine effect
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    for (int dy = -radius/2; dy <= radius/2; dy++) {
-        for (int dx = -radius/2; dx <= radius/2; dx++) {
-            if (dx*dx + dy*dy <= (radius/3)*(radius/3)) {
-                SDL_RenderDrawPoint(renderer, centerX + dx - radius/3, centerY + dy - radius/3);
-            }
-        }
+    CompactColumn(m_x, m_keep);
+    CompactColumn(m_y, m_keep);
+    CompactColumn(m_floatOffset, m_keep);
+    CompactColumn(m_isCollected, m_keep);
+    CompactColumn(m_value, m_keep);
+    CompactColumn(m_animationTimer, m_keep);
+    return removed;
+}
+
+void CoinStore::SaveState(StateWriter& out) const {
+    WriteColumns(out, m_x, m_y, m_floatOffset, m_isCollected, m_value, m_animationTimer);
+}
+
+bool CoinStore::LoadState(StateReader& in) {
+    return ReadColumns(in, m_x, m_y, m_floatOffset, m_isCollected, m_value, m_animationTimer) &&
+           AllWithin(MAX_STATE_COORDINATE, m_x, m_y, m_floatOffset) && AllFinite(m_animationTimer);
+}
+
+void CoinStore::Update(float deltaTime, size_t begin, size_t end) {
+    // Floating animation. Collected coins are advanced as well: skipping them
+    // would cost more than the branch-free pass saves.
+    for (size_t i = begin; i < end; i++) {
+        m_animationTimer[i] += deltaTime * ANIMATION_SPEED;
     }
-    
-    // Draw dollar sign in the center
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_Rect dollarLine1 = {centerX - 1, centerY - 6, 2, 4};
-    SDL_Rect dollarLine2 = {centerX - 1, centerY + 2, 2, 4};
-    SDL_Rect dollarVert = {centerX - 1, centerY - 8, 2, 16};
-    SDL_RenderFillRect(renderer, &dollarLine1);
-    SDL_RenderFillRect(renderer, &dollarLine2);
-    SDL_RenderFillRect(renderer, &dollarVert);
+    EvaluateWave(&m_animationTimer[begin], end - begin, 1.0f, FLOAT_AMPLITUDE, 0.0f, &m_floatOffset[begin]);
+}
+
+Rectangle CoinStore::GetBounds(int index) const {
+    if (m_isCollected[index]) return Rectangle(0, 0, 0, 0);
+    return Rectangle(m_x[index], m_y[index] + m_floatOffset[index], WIDTH, HEIGHT);
 }
 
-Rectangle Coin::GetBounds() const {
-    if (m_isCollected) return Rectangle(0, 0, 0, 0);
-    return Rectangle(m_position.x, m_position.y + m_floatOffset, m_width, m_height);
-} 
\ No newline at end of file
+int CoinStore::CountCollected() const {
+    int coinsCollected = 0;
+    for (std::uint8_t collected : m_isCollected) {
+        coinsCollected += collected;
+    }
+    return coinsCollected;
+}
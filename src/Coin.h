@@ -1,28 +1,63 @@
 #pragma once
-#include "Game.h"
-#include <SDL2/SDL.h>
+#include "Types.h"
+#include "LevelArena.h"
+#include <vector>
+#include <cstdint>
 
-class Coin {
+class RenderQueue;
+class StateWriter;
+class StateReader;
+class SpriteAtlas;
+
+// Coins stored as parallel arrays (structure of arrays)
+class CoinStore {
 public:
-    Coin(float x, float y);
+    // Columns take their storage from arena when given (it must outlive the store), else from the heap
+    explicit CoinStore(LevelArena* arena = nullptr);
+    
+    // Remove every entity and give the storage back, e.g. before the arena is reset
+    void Clear();
+    void Reserve(size_t count);
+    int Add(float x, float y);
+    void AddRange(size_t count, const float* x, const float* y);
+    size_t RemoveLeftOf(float x);
+    size_t Size() const { return m_x.size(); }
+    
+    // Write every column to a saved-state image, or replace them with the ones read from it
+    void SaveState(StateWriter& out) const;
+    bool LoadState(StateReader& in);
     
-    void Update(float deltaTime);
-    void Render(SDL_Renderer* renderer);
-    Rectangle GetBounds() const;
+    // Advance the float animation; the offsets of the whole range come out of one vectorized pass
+    void Update(float deltaTime) { Update(deltaTime, 0, Size()); }
+    // Only coins [begin, end); disjoint ranges may be updated in parallel
+    void Update(float deltaTime, size_t begin, size_t end);
+    // Only coins that intersect view are drawn
+    void Render(RenderQueue& queue, const SpriteAtlas& sprites, const Rectangle& view) const;
     
-    bool IsCollected() const { return m_isCollected; }
-    void Collect() { m_isCollected = true; }
-    int GetValue() const { return m_value; }
+    // Register the coin visual with the sprite atlas
+    static void BakeSprites(SpriteAtlas& atlas);
+    Rectangle GetBounds(int index) const;
+    
+    bool IsCollected(int index) const { return m_isCollected[index] != 0; }
+    void Collect(int index) { m_isCollected[index] = 1; }
+    int GetValue(int index) const { return m_value[index]; }
+    int CountCollected() const;
+    
+    static const float WIDTH;
+    static const float HEIGHT;
     
 private:
-    Vector2 m_position;
-    float m_width;
-    float m_height;
-    bool m_isCollected;
-    int m_value;
-    float m_animationTimer;
-    float m_floatOffset;
+    // Hot data
+    ArenaVector<float> m_x;
+    ArenaVector<float> m_y;
+    ArenaVector<float> m_floatOffset;
+    ArenaVector<std::uint8_t> m_isCollected;
+    
+    // Cold data
+    ArenaVector<int> m_value;
+    ArenaVector<float> m_animationTimer;
+    ArenaVector<std::uint8_t> m_keep;  // RemoveLeftOf() scratch
     
     static const float ANIMATION_SPEED;
     static const float FLOAT_AMPLITUDE;
-}; 
\ No newline at end of file
+};
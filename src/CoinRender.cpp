@@ -0,0 +1,59 @@
+#include "Coin.h"
+#include "RenderQueue.h"
+#include "SpriteAtlas.h"
+
+// Gold coin with shine effect and dollar sign around the given centre
+static void DrawCoin(RenderQueue& queue, int centerX, int centerY, int radius) {
+    // Draw coin as a yellow circle with shine effect
+    queue.SetDrawColor(255, 215, 0, 255); // Gold color
+    
+    // Draw filled circle (approximate)
+    for (int dy = -radius; dy <= radius; dy++) {
+        for (int dx = -radius; dx <= radius; dx++) {
+            if (dx*dx + dy*dy <= radius*radius) {
+                queue.DrawPoint(centerX + dx, centerY + dy);
+            }
+        }
+    }
+    
+    // Add shine effect
+    queue.SetDrawColor(255, 255, 255, 255);
+    for (int dy = -radius/2; dy <= radius/2; dy++) {
+        for (int dx = -radius/2; dx <= radius/2; dx++) {
+            if (dx*dx + dy*dy <= (radius/3)*(radius/3)) {
+                queue.DrawPoint(centerX + dx - radius/3, centerY + dy - radius/3);
+            }
+        }
+    }
+    
+    // Draw dollar sign in the center
+    queue.SetDrawColor(0, 0, 0, 255);
+    SDL_Rect dollarLine1 = {centerX - 1, centerY - 6, 2, 4};
+    SDL_Rect dollarLine2 = {centerX - 1, centerY + 2, 2, 4};
+    SDL_Rect dollarVert = {centerX - 1, centerY - 8, 2, 16};
+    queue.FillRect(dollarLine1);
+    queue.FillRect(dollarLine2);
+    queue.FillRect(dollarVert);
+}
+
+void CoinStore::BakeSprites(SpriteAtlas& atlas) {
+    // The circle covers the coin bounds plus its right/bottom edge pixel
+    int radius = static_cast<int>(WIDTH/2);
+    atlas.AddSheet(SpriteSheet::COIN, 1, radius*2 + 1, radius*2 + 1, 0, 0,
+        [radius](RenderQueue& queue, int, int x, int y) {
+            DrawCoin(queue, x + radius, y + radius, radius);
+        });
+}
+
+void CoinStore::Render(RenderQueue& queue, const SpriteAtlas& sprites, const Rectangle& view) const {
+    queue.SetLayer(RenderLayer::COINS);
+    
+    for (size_t i = 0; i < m_x.size(); i++) {
+        if (m_isCollected[i] || !GetBounds(static_cast<int>(i)).Expand(1.0f).Intersects(view)) continue;
+        
+        queue.BeginItem();
+        
+        float renderY = m_y[i] + m_floatOffset[i];
+        sprites.Draw(queue, SpriteSheet::COIN, 0, static_cast<int>(m_x[i]), static_cast<int>(renderY));
+    }
+}
@@ -0,0 +1,90 @@
+#include "CollisionMap.h"
+#include "Platform.h"
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+const float CollisionMap::CELL_SIZE = 8.0f;
+
+// A power of two, so scaling a coordinate into cells is exact and cell
+// boundaries fall exactly where the platform edges are compared
+static const float INVERSE_CELL_SIZE = 0.125f;
+
+CollisionMap::CollisionMap()
+    : m_firstColumn(0), m_firstRow(0), m_columns(0), m_rows(0), m_wordsPerRow(0), m_exact(nullptr) {
+}
+
+void CollisionMap::Build(const Rectangle& area, const PlatformStore& platforms, const SpatialGrid& exact) {
+    m_exact = &exact;
+    m_firstColumn = static_cast<int>(std::floor(area.x * INVERSE_CELL_SIZE));
+    m_firstRow = static_cast<int>(std::floor(area.y * INVERSE_CELL_SIZE));
+    m_columns = static_cast<int>(std::floor((area.x + area.width) * INVERSE_CELL_SIZE)) - m_firstColumn + 1;
+    m_rows = static_cast<int>(std::floor((area.y + area.height) * INVERSE_CELL_SIZE)) - m_firstRow + 1;
+    m_wordsPerRow = (m_columns + 63) / 64;
+    
+    // assign() keeps the capacity, so rebuilding while streaming allocates nothing once warmed up
+    size_t words = static_cast<size_t>(m_wordsPerRow) * m_rows;
+    m_solid.assign(words, 0);
+    m_touched.assign(words, 0);
+    
+    for (int i = 0; i < static_cast<int>(platforms.Size()); i++) {
+        Rectangle bounds = platforms.GetBounds(i);
+        float left = bounds.x * INVERSE_CELL_SIZE;
+        float top = bounds.y * INVERSE_CELL_SIZE;
+        float right = (bounds.x + bounds.width) * INVERSE_CELL_SIZE;
+        float bottom = (bounds.y + bounds.height) * INVERSE_CELL_SIZE;
+        
+        // The closed rectangle touches cell c when left < c + 1 and c <= right,
+        // and covers it when left <= c and c + 1 <= right
+        int touchedLeft = std::max(static_cast<int>(std::floor(left)) - m_firstColumn, 0);
+        int touchedRight = std::min(static_cast<int>(std::floor(right)) - m_firstColumn, m_columns - 1);
+        int touchedTop = std::max(static_cast<int>(std::floor(top)) - m_firstRow, 0);
+        int touchedBottom = std::min(static_cast<int>(std::floor(bottom)) - m_firstRow, m_rows - 1);
+        int solidLeft = std::max(static_cast<int>(std::ceil(left)) - m_firstColumn, 0);
+        int solidRight = std::min(static_cast<int>(std::floor(right)) - 1 - m_firstColumn, m_columns - 1);
+        int solidTop = std::max(static_cast<int>(std::ceil(top)) - m_firstRow, 0);
+        int solidBottom = std::min(static_cast<int>(std::floor(bottom)) - 1 - m_firstRow, m_rows - 1);
+        
+        for (int row = touchedTop; row <= touchedBottom; row++) {
+            SetRun(m_touched, row, touchedLeft, touchedRight);
+        }
+        for (int row = solidTop; row <= solidBottom; row++) {
+            SetRun(m_solid, row, solidLeft, solidRight);
+        }
+    }
+}
+
+void CollisionMap::SetRun(std::vector<std::uint64_t>& plane, int row, int first, int last) {
+    if (first > last) return;
+    
+    std::uint64_t* words = plane.data() + static_cast<size_t>(row) * m_wordsPerRow;
+    int firstWord = first / 64;
+    int lastWord = last / 64;
+    std::uint64_t firstMask = ~0ull << (first % 64);
+    std::uint64_t lastMask = ~0ull >> (63 - last % 64);
+    if (firstWord == lastWord) {
+        words[firstWord] |= firstMask & lastMask;
+        return;
+    }
+    words[firstWord] |= firstMask;
+    for (int word = firstWord + 1; word < lastWord; word++) {
+        words[word] = ~0ull;
+    }
+    words[lastWord] |= lastMask;
+}
+
+bool CollisionMap::IsSolid(const Vector2& point) const {
+    if (!m_exact) return false;
+    
+    // Compared as floats first so far-off (or NaN) points never overflow the cast
+    float column = std::floor(point.x * INVERSE_CELL_SIZE) - m_firstColumn;
+    float row = std::floor(point.y * INVERSE_CELL_SIZE) - m_firstRow;
+    if (column >= 0.0f && column < m_columns && row >= 0.0f && row < m_rows) {
+        int x = static_cast<int>(column);
+        size_t word = static_cast<size_t>(row) * m_wordsPerRow + x / 64;
+        std::uint64_t bit = 1ull << (x % 64);
+        if (m_solid[word] & bit) return true;
+        if (!(m_touched[word] & bit)) return false;
+    }
+    return m_exact->AnyContains(point);
+}
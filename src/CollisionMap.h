@@ -0,0 +1,40 @@
+#pragma once
+#include "Types.h"
+#include <cstdint>
+#include <vector>
+
+class PlatformStore;
+class SpatialGrid;
+
+// Static platforms baked into a bitmap of 8 x 8 pixel cells so that point
+// probes (an enemy looking for ground ahead of it) cost one bit test however
+// many platforms the level has. Each cell is solid (inside one platform),
+// empty (touched by none) or mixed. Only probes into mixed cells, i.e. next to
+// a platform edge, and probes outside the baked area go on to the exact test
+// against the platform grid, so answers match SpatialGrid::AnyContains().
+class CollisionMap {
+public:
+    CollisionMap();
+    
+    // Bake the platforms over area. exact must hold the same platforms and stay
+    // unchanged until the next Build(); mixed cells are looked up there.
+    void Build(const Rectangle& area, const PlatformStore& platforms, const SpatialGrid& exact);
+    
+    // True if any platform contains the point (edges inclusive)
+    bool IsSolid(const Vector2& point) const;
+    
+    static const float CELL_SIZE;
+    
+private:
+    // Set bits [first, last] of one row of a plane
+    void SetRun(std::vector<std::uint64_t>& plane, int row, int first, int last);
+    
+    int m_firstColumn;  // Cell coordinates of the top left baked cell
+    int m_firstRow;
+    int m_columns;
+    int m_rows;
+    int m_wordsPerRow;
+    std::vector<std::uint64_t> m_solid;    // One bit per cell, rows padded to whole words
+    std::vector<std::uint64_t> m_touched;  // Cells some platform touches, solid or mixed
+    const SpatialGrid* m_exact;
+};
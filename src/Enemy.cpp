@@ -1,138 +1,225 @@
 #include "Enemy.h"
-#include "Platform.h"
+#include "StoreColumns.h"
+#include "CollisionMap.h"
+#include <algorithm>
 #include <cmath>
 
-const float Enemy::MOVE_SPEED = 50.0f;
-const float Enemy::EDGE_DETECTION_DISTANCE = 30.0f;
+const float EnemyStore::WIDTH = 25.0f;
+const float EnemyStore::HEIGHT = 25.0f;
+const float EnemyStore::MOVE_SPEED = 50.0f;
+const float EnemyStore::EDGE_DETECTION_DISTANCE = 30.0f;
+const float EnemyStore::PATROL_PROBE_STEP = 4.0f;
 
-Enemy::Enemy(float x, float y) 
-    : m_position(x, y), m_velocity(-MOVE_SPEED, 0), m_width(25), m_height(25), 
-      m_isAlive(true), m_movingRight(false), m_isOnGround(false), m_animationTimer(0.0f) {
+EnemyStore::EnemyStore(LevelArena* arena) 
+    : m_x(arena), m_y(arena), m_previousX(arena), m_previousY(arena), m_velocityX(arena), m_velocityY(arena), 
+      m_isAlive(arena), m_isOnGround(arena), m_movingRight(arena), m_animationTimer(arena), 
+      m_sleepTime(arena), m_keep(arena) {
 }
 
-void Enemy::Update(float deltaTime, const std::vector<std::unique_ptr<Platform>>& platforms) {
-    if (!m_isAlive) return;
-    
-    m_animationTimer += deltaTime * 4.0f;
-    
-    // Apply gravity
-    if (!m_isOnGround) {
-        m_velocity.y += 800.0f * deltaTime; // Same gravity as player
-        m_velocity.y = std::min(m_velocity.y, 500.0f); // Max fall speed
-    }
-    
-    // Edge detection - check if enemy would fall off platform
-    bool foundGround = false;
-    Vector2 futurePosition = m_position + Vector2(m_velocity.x * deltaTime * 2, 0);
-    Vector2 groundCheckPos = futurePosition + Vector2(m_width/2, m_height + 5);
-    
-    for (const auto& platform : platforms) {
-        Rectangle platformBounds = platform->GetBounds();
-        if (groundCheckPos.x >= platformBounds.x && 
-            groundCheckPos.x <= platformBounds.x + platformBounds.width &&
-            groundCheckPos.y >= platformBounds.y && 
-            groundCheckPos.y <= platformBounds.y + platformBounds.height) {
-            foundGround = true;
-            break;
+void EnemyStore::Clear() {
+    ReleaseColumn(m_x);
+    ReleaseColumn(m_y);
+    ReleaseColumn(m_previousX);
+    ReleaseColumn(m_previousY);
+    ReleaseColumn(m_velocityX);
+    ReleaseColumn(m_velocityY);
+    ReleaseColumn(m_isAlive);
+    ReleaseColumn(m_isOnGround);
+    ReleaseColumn(m_movingRight);
+    ReleaseColumn(m_animationTimer);
+    ReleaseColumn(m_sleepTime);
+    ReleaseColumn(m_keep);
+}
+
+void EnemyStore::Reserve(size_t count) {
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_previousX.reserve(count);
+    m_previousY.reserve(count);
+    m_velocityX.reserve(count);
+    m_velocityY.reserve(count);
+    m_isAlive.reserve(count);
+    m_isOnGround.reserve(count);
+    m_movingRight.reserve(count);
+    m_animationTimer.reserve(count);
+    m_sleepTime.reserve(count);
+    m_keep.reserve(count);
+}
+
+int EnemyStore::Add(float x, float y) {
+    m_x.push_back(x);
+    m_y.push_back(y);
+    m_previousX.push_back(x);
+    m_previousY.push_back(y);
+    m_velocityX.push_back(-MOVE_SPEED);
+    m_velocityY.push_back(0.0f);
+    m_isAlive.push_back(1);
+    m_isOnGround.push_back(0);
+    m_movingRight.push_back(0);
+    m_animationTimer.push_back(0.0f);
+    m_sleepTime.push_back(0.0f);
+    return static_cast<int>(m_x.size()) - 1;
+}
+
+void EnemyStore::AddRange(size_t count, const float* x, const float* y) {
+    m_x.insert(m_x.end(), x, x + count);
+    m_y.insert(m_y.end(), y, y + count);
+    m_previousX.insert(m_previousX.end(), x, x + count);
+    m_previousY.insert(m_previousY.end(), y, y + count);
+    m_velocityX.insert(m_velocityX.end(), count, -MOVE_SPEED);
+    m_velocityY.insert(m_velocityY.end(), count, 0.0f);
+    m_isAlive.insert(m_isAlive.end(), count, 1);
+    m_isOnGround.insert(m_isOnGround.end(), count, 0);
+    m_movingRight.insert(m_movingRight.end(), count, 0);
+    m_animationTimer.insert(m_animationTimer.end(), count, 0.0f);
+    m_sleepTime.insert(m_sleepTime.end(), count, 0.0f);
+}
+
+size_t EnemyStore::RemoveLeftOf(float x) {
+    size_t removed = MarkLeftOf(m_x, WIDTH, x, m_keep);
+    if (removed == 0) return 0;
+    
+    CompactColumn(m_x, m_keep);
+    CompactColumn(m_y, m_keep);
+    CompactColumn(m_previousX, m_keep);
+    CompactColumn(m_previousY, m_keep);
+    CompactColumn(m_velocityX, m_keep);
+    CompactColumn(m_velocityY, m_keep);
+    CompactColumn(m_isAlive, m_keep);
+    CompactColumn(m_isOnGround, m_keep);
+    CompactColumn(m_movingRight, m_keep);
+    CompactColumn(m_animationTimer, m_keep);
+    CompactColumn(m_sleepTime, m_keep);
+    return removed;
+}
+
+void EnemyStore::SaveState(StateWriter& out) const {
+    WriteColumns(out, m_x, m_y, m_previousX, m_previousY, m_velocityX, m_velocityY, m_isAlive, m_isOnGround,
+                     m_movingRight, m_animationTimer, m_sleepTime);
+}
+
+bool EnemyStore::LoadState(StateReader& in) {
+    return ReadColumns(in, m_x, m_y, m_previousX, m_previousY, m_velocityX, m_velocityY, m_isAlive, m_isOnGround,
+                           m_movingRight, m_animationTimer, m_sleepTime) &&
+           AllWithin(MAX_STATE_COORDINATE, m_x, m_y, m_previousX, m_previousY) &&
+           AllFinite(m_velocityX, m_velocityY, m_animationTimer, m_sleepTime);
+}
+
+void EnemyStore::StorePreviousState() {
+    m_previousX = m_x;
+    m_previousY = m_y;
+}
+
+void EnemyStore::Update(float deltaTime, const CollisionMap& ground, float levelWidth, const Rectangle& activeArea, 
+                        size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        if (!m_isAlive[i]) continue;
+        
+        // Falling enemies keep updating until they land, so sleepers are always standing
+        if (m_isOnGround[i] && !GetBounds(static_cast<int>(i)).Intersects(activeArea)) {
+            m_sleepTime[i] += deltaTime;
+            continue;
         }
+        if (m_sleepTime[i] > 0) {
+            CatchUp(i, ground, levelWidth);
+        }
+        
+        m_animationTimer[i] += deltaTime * 4.0f;
+        
+        // Apply gravity
+        if (!m_isOnGround[i]) {
+            m_velocityY[i] += 800.0f * deltaTime; // Same gravity as player
+            m_velocityY[i] = std::min(m_velocityY[i], 500.0f); // Max fall speed
+        }
+        
+        // Edge detection - check if enemy would fall off platform
+        float futureX = m_x[i] + m_velocityX[i] * deltaTime * 2;
+        Vector2 groundCheckPos(futureX + WIDTH/2, m_y[i] + HEIGHT + 5);
+        bool foundGround = ground.IsSolid(groundCheckPos);
+        
+        // Change direction if no ground ahead or hit boundary
+        if (!foundGround || m_x[i] <= 0 || m_x[i] >= levelWidth - WIDTH) {
+            m_velocityX[i] = -m_velocityX[i];
+            m_movingRight[i] = !m_movingRight[i];
+        }
+        
+        // Update position
+        m_x[i] += m_velocityX[i] * deltaTime;
+        m_y[i] += m_velocityY[i] * deltaTime;
+        
+        // Keep enemy in bounds
+        if (m_x[i] < 0) m_x[i] = 0;
+        if (m_x[i] > levelWidth - WIDTH) m_x[i] = levelWidth - WIDTH;
+        
+        // Ground contact is re-established by platform collision resolution
+        m_isOnGround[i] = 0;
     }
-    
-    // Change direction if no ground ahead or hit boundary
-    if (!foundGround || m_position.x <= 0 || m_position.x >= 1000 - m_width) {
-        m_velocity.x = -m_velocity.x;
-        m_movingRight = !m_movingRight;
-    }
-    
-    // Update position
-    m_position = m_position + m_velocity * deltaTime;
-    
-    // Keep enemy in bounds
-    if (m_position.x < 0) m_position.x = 0;
-    if (m_position.x > 1000 - m_width) m_position.x = 1000 - m_width;
 }
 
-void Enemy::Render(SDL_Renderer* renderer) {
-    if (!m_isAlive) return;
-    
-    // Walking animation offset
-    float walkOffset = sin(m_animationTimer) * 2;
-    
-    // Draw enemy as a dark red rectangle with animation
-    SDL_SetRenderDrawColor(renderer, 139, 0, 0, 255);
-    SDL_Rect enemyRect = {
-        static_cast<int>(m_position.x),
-        static_cast<int>(m_position.y + walkOffset),
-        static_cast<int>(m_width),
-        static_cast<int>(m_height)
-    };
-    SDL_RenderFillRect(renderer, &enemyRect);
-    
-    // Draw legs for walking animation
-    SDL_SetRenderDrawColor(renderer, 100, 0, 0, 255);
-    float legOffset = sin(m_animationTimer + 1.5f) * 3;
-    SDL_Rect leftLeg = {
-        static_cast<int>(m_position.x + 3),
-        static_cast<int>(m_position.y + m_height - 8 + legOffset),
-        4, 8
-    };
-    SDL_Rect rightLeg = {
-        static_cast<int>(m_position.x + m_width - 7),
-        static_cast<int>(m_position.y + m_height - 8 - legOffset),
-        4, 8
-    };
-    SDL_RenderFillRect(renderer, &leftLeg);
-    SDL_RenderFillRect(renderer, &rightLeg);
-    
-    // Draw angry eyes
-    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); // Red eyes for angry look
-    int eyeSize = 3;
-    int eyeY = static_cast<int>(m_position.y + 6 + walkOffset);
-    
-    SDL_Rect leftEye = {static_cast<int>(m_position.x + 5), eyeY, eyeSize, eyeSize};
-    SDL_Rect rightEye = {static_cast<int>(m_position.x + m_width - 8), eyeY, eyeSize, eyeSize};
-    SDL_RenderFillRect(renderer, &leftEye);
-    SDL_RenderFillRect(renderer, &rightEye);
+void EnemyStore::CatchUp(size_t i, const CollisionMap& ground, float levelWidth) {
+    float sleepTime = m_sleepTime[i];
+    m_sleepTime[i] = 0.0f;
+    m_animationTimer[i] += sleepTime * 4.0f;
+    
+    // Find how far the ground continues on either side, probing like Update()
+    // does but only as far as the enemy could have walked. Walls it would have
+    // bounced off are not detected; collision resolution pushes it out of them.
+    float distance = MOVE_SPEED * sleepTime;
+    float probeY = m_y[i] + HEIGHT + 5;
+    float left = m_x[i];
+    while (left > m_x[i] - distance && left - PATROL_PROBE_STEP >= 0 && 
+           ground.IsSolid(Vector2(left - PATROL_PROBE_STEP + WIDTH/2, probeY))) {
+        left -= PATROL_PROBE_STEP;
+    }
+    float right = m_x[i];
+    while (right < m_x[i] + distance && right + PATROL_PROBE_STEP <= levelWidth - WIDTH && 
+           ground.IsSolid(Vector2(right + PATROL_PROBE_STEP + WIDTH/2, probeY))) {
+        right += PATROL_PROBE_STEP;
+    }
     
-    // Draw angry eyebrows
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    if (m_movingRight) {
-        SDL_RenderDrawLine(renderer, 
-            static_cast<int>(m_position.x + 4), static_cast<int>(m_position.y + 4 + walkOffset),
-            static_cast<int>(m_position.x + 9), static_cast<int>(m_position.y + 6 + walkOffset));
-        SDL_RenderDrawLine(renderer, 
-            static_cast<int>(m_position.x + m_width - 9), static_cast<int>(m_position.y + 4 + walkOffset),
-            static_cast<int>(m_position.x + m_width - 4), static_cast<int>(m_position.y + 6 + walkOffset));
-    } else {
-        SDL_RenderDrawLine(renderer, 
-            static_cast<int>(m_position.x + 9), static_cast<int>(m_position.y + 4 + walkOffset),
-            static_cast<int>(m_position.x + 4), static_cast<int>(m_position.y + 6 + walkOffset));
-        SDL_RenderDrawLine(renderer, 
-            static_cast<int>(m_position.x + m_width - 4), static_cast<int>(m_position.y + 4 + walkOffset),
-            static_cast<int>(m_position.x + m_width - 9), static_cast<int>(m_position.y + 6 + walkOffset));
+    // Fold the walked distance into one out-and-back cycle over [left, right]
+    float span = right - left;
+    if (span > 0.0f) {
+        float cycle = 2.0f * span;
+        bool movingRight = m_velocityX[i] > 0;
+        float progress = movingRight ? m_x[i] - left : cycle - (m_x[i] - left);
+        progress = fmod(progress + distance, cycle);
+        
+        movingRight = progress < span;
+        m_x[i] = movingRight ? left + progress : left + cycle - progress;
+        m_velocityX[i] = movingRight ? MOVE_SPEED : -MOVE_SPEED;
+        m_movingRight[i] = movingRight;
     }
     
-    // Draw direction indicator (spikes)
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    int centerY = static_cast<int>(m_position.y + m_height/2 + walkOffset);
-    if (m_movingRight) {
-        SDL_RenderDrawLine(renderer, 
-            static_cast<int>(m_position.x + m_width - 2), centerY - 3,
-            static_cast<int>(m_position.x + m_width + 2), centerY);
-        SDL_RenderDrawLine(renderer, 
-            static_cast<int>(m_position.x + m_width - 2), centerY + 3,
-            static_cast<int>(m_position.x + m_width + 2), centerY);
-    } else {
-        SDL_RenderDrawLine(renderer, 
-            static_cast<int>(m_position.x + 2), centerY - 3,
-            static_cast<int>(m_position.x - 2), centerY);
-        SDL_RenderDrawLine(renderer, 
-            static_cast<int>(m_position.x + 2), centerY + 3,
-            static_cast<int>(m_position.x - 2), centerY);
+    // Don't interpolate across the jump
+    m_previousX[i] = m_x[i];
+}
+
+void EnemyStore::ResolveCollision(int index, const Rectangle& platform, const Vector2& normal) {
+    if (normal.y < 0) {
+        // Landing on top of platform
+        m_y[index] = platform.y - HEIGHT;
+        m_velocityY[index] = 0;
+        m_isOnGround[index] = 1;
+    } else if (normal.y > 0) {
+        // Hitting platform from below
+        m_y[index] = platform.y + platform.height;
+        m_velocityY[index] = 0;
+    } else if (normal.x < 0) {
+        // Hitting platform from left - change direction
+        m_x[index] = platform.x - WIDTH;
+        m_velocityX[index] = -MOVE_SPEED;
+        m_movingRight[index] = 0;
+    } else if (normal.x > 0) {
+        // Hitting platform from right - change direction
+        m_x[index] = platform.x + platform.width;
+        m_velocityX[index] = MOVE_SPEED;
+        m_movingRight[index] = 1;
     }
 }
 
-void Enemy::ResolveCollision(const Rectangle& platform) {
-    Rectangle enemyBounds = GetBounds();
+void EnemyStore::ResolveCollision(int index, const Rectangle& platform) {
+    Rectangle enemyBounds = GetBounds(index);
     
     // Calculate overlap
     float overlapLeft = (enemyBounds.x + enemyBounds.width) - platform.x;
@@ -143,28 +230,13 @@ void Enemy::ResolveCollision(const Rectangle& platform) {
     // Find minimum overlap
     float minOverlap = std::min({overlapLeft, overlapRight, overlapTop, overlapBottom});
     
-    if (minOverlap == overlapTop && m_velocity.y >= 0) {
-        // Landing on top of platform
-        m_position.y = platform.y - m_height;
-        m_velocity.y = 0;
-        m_isOnGround = true;
-    } else if (minOverlap == overlapBottom && m_velocity.y < 0) {
-        // Hitting platform from below
-        m_position.y = platform.y + platform.height;
-        m_velocity.y = 0;
-    } else if (minOverlap == overlapLeft && m_velocity.x > 0) {
-        // Hitting platform from left - change direction
-        m_position.x = platform.x - m_width;
-        m_velocity.x = -MOVE_SPEED;
-        m_movingRight = false;
-    } else if (minOverlap == overlapRight && m_velocity.x < 0) {
-        // Hitting platform from right - change direction
-        m_position.x = platform.x + platform.width;
-        m_velocity.x = MOVE_SPEED;
-        m_movingRight = true;
+    if (minOverlap == overlapTop && m_velocityY[index] >= 0) {
+        ResolveCollision(index, platform, Vector2(0, -1));
+    } else if (minOverlap == overlapBottom && m_velocityY[index] < 0) {
+        ResolveCollision(index, platform, Vector2(0, 1));
+    } else if (minOverlap == overlapLeft && m_velocityX[index] > 0) {
+        ResolveCollision(index, platform, Vector2(-1, 0));
+    } else if (minOverlap == overlapRight && m_velocityX[index] < 0) {
+        ResolveCollision(index, platform, Vector2(1, 0));
     }
 }
-
-Rectangle Enemy::GetBounds() const {
-    return Rectangle(m_position.x, m_position.y, m_width, m_height);
-} 
\ No newline at end of file
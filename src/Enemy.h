@@ -1,32 +1,87 @@
 #pragma once
-#include "Game.h"
-#include <SDL2/SDL.h>
+#include "Types.h"
+#include "LevelArena.h"
+#include <vector>
+#include <cstdint>
 
-class Enemy {
+class RenderQueue;
+class StateWriter;
+class StateReader;
+class CollisionMap;
+class SpriteAtlas;
+
+// Enemies stored as parallel arrays (structure of arrays) so per-tick
+// loops walk contiguous position/velocity data
+class EnemyStore {
 public:
-    Enemy(float x, float y);
+    // Columns take their storage from arena when given (it must outlive the store), else from the heap
+    explicit EnemyStore(LevelArena* arena = nullptr);
+    
+    // Remove every entity and give the storage back, e.g. before the arena is reset
+    void Clear();
+    void Reserve(size_t count);
+    int Add(float x, float y);
+    void AddRange(size_t count, const float* x, const float* y);
+    size_t RemoveLeftOf(float x);
+    size_t Size() const { return m_x.size(); }
+    
+    // Write every column to a saved-state image, or replace them with the ones read from it
+    void SaveState(StateWriter& out) const;
+    bool LoadState(StateReader& in);
+    
+    // Walk, fall and turn at ledges or the level edges for every live enemy.
+    // Grounded enemies outside activeArea sleep; on waking they are moved to
+    // where their patrol would have taken them in the meantime.
+    void Update(float deltaTime, const CollisionMap& ground, float levelWidth, const Rectangle& activeArea) {
+        Update(deltaTime, ground, levelWidth, activeArea, 0, Size());
+    }
+    // Only enemies [begin, end); disjoint ranges may be updated in parallel
+    void Update(float deltaTime, const CollisionMap& ground, float levelWidth, const Rectangle& activeArea, 
+                size_t begin, size_t end);
+    // Only enemies that intersect view are drawn
+    void Render(RenderQueue& queue, const SpriteAtlas& sprites, const Rectangle& view, float alpha = 1.0f) const;
+    
+    // Register the walk cycle in both directions with the sprite atlas
+    static void BakeSprites(SpriteAtlas& atlas);
     
-    void Update(float deltaTime, const std::vector<std::unique_ptr<class Platform>>& platforms);
-    void Render(SDL_Renderer* renderer);
-    Rectangle GetBounds() const;
+    // Remember current positions as the start of the next interpolation span
+    void StorePreviousState();
     
-    bool IsAlive() const { return m_isAlive; }
-    void Kill() { m_isAlive = false; }
+    Rectangle GetBounds(int index) const { return Rectangle(m_x[index], m_y[index], WIDTH, HEIGHT); }
+    Rectangle GetPreviousBounds(int index) const { return Rectangle(m_previousX[index], m_previousY[index], WIDTH, HEIGHT); }
+    bool IsAlive(int index) const { return m_isAlive[index] != 0; }
+    bool IsAwake(int index) const { return m_sleepTime[index] == 0; }
+    void Kill(int index) { m_isAlive[index] = 0; }
     
-    // Platform collision
-    void ResolveCollision(const Rectangle& platform);
-    void SetOnGround(bool onGround) { m_isOnGround = onGround; }
+    // Platform collision: stop against (or turn at) the side of platform that
+    // was run into, or push out of an overlapping platform along the shallowest axis
+    void ResolveCollision(int index, const Rectangle& platform, const Vector2& normal);
+    void ResolveCollision(int index, const Rectangle& platform);
+    
+    static const float WIDTH;
+    static const float HEIGHT;
     
 private:
-    Vector2 m_position;
-    Vector2 m_velocity;
-    float m_width;
-    float m_height;
-    bool m_isAlive;
-    bool m_movingRight;
-    bool m_isOnGround;
-    float m_animationTimer;
+    // Hot data
+    ArenaVector<float> m_x;
+    ArenaVector<float> m_y;
+    ArenaVector<float> m_previousX;
+    ArenaVector<float> m_previousY;
+    ArenaVector<float> m_velocityX;
+    ArenaVector<float> m_velocityY;
+    ArenaVector<std::uint8_t> m_isAlive;
+    ArenaVector<std::uint8_t> m_isOnGround;
+    
+    // Animation state
+    ArenaVector<std::uint8_t> m_movingRight;
+    ArenaVector<float> m_animationTimer;
+    
+    ArenaVector<float> m_sleepTime;  // Time missed while outside the active area
+    ArenaVector<std::uint8_t> m_keep;  // RemoveLeftOf() scratch
+    
+    void CatchUp(size_t index, const CollisionMap& ground, float levelWidth);
     
     static const float MOVE_SPEED;
     static const float EDGE_DETECTION_DISTANCE;
-}; 
\ No newline at end of file
+    static const float PATROL_PROBE_STEP;
+};
@@ -0,0 +1,117 @@
+#include "Enemy.h"
+#include "RenderQueue.h"
+#include "SpriteAtlas.h"
+#include <cmath>
+
+static const int ENEMY_FRAMES = 16;        // Baked steps of the walk cycle
+static const int ENEMY_SPRITE_MARGIN = 4;  // Room for the bob, legs and spikes outside the bounds
+
+// Enemy body, legs, eyes and direction spikes for one point of the walk cycle
+static void DrawEnemy(RenderQueue& queue, const Vector2& position, float animationTimer, bool movingRight) {
+    // Walking animation offset
+    float walkOffset = sin(animationTimer) * 2;
+    
+    // Draw enemy as a dark red rectangle with animation
+    queue.SetDrawColor(139, 0, 0, 255);
+    SDL_Rect enemyRect = {
+        static_cast<int>(position.x),
+        static_cast<int>(position.y + walkOffset),
+        static_cast<int>(EnemyStore::WIDTH),
+        static_cast<int>(EnemyStore::HEIGHT)
+    };
+    queue.FillRect(enemyRect);
+    
+    // Draw legs for walking animation
+    queue.SetDrawColor(100, 0, 0, 255);
+    float legOffset = sin(animationTimer + 1.5f) * 3;
+    SDL_Rect leftLeg = {
+        static_cast<int>(position.x + 3),
+        static_cast<int>(position.y + EnemyStore::HEIGHT - 8 + legOffset),
+        4, 8
+    };
+    SDL_Rect rightLeg = {
+        static_cast<int>(position.x + EnemyStore::WIDTH - 7),
+        static_cast<int>(position.y + EnemyStore::HEIGHT - 8 - legOffset),
+        4, 8
+    };
+    queue.FillRect(leftLeg);
+    queue.FillRect(rightLeg);
+    
+    // Draw angry eyes
+    queue.SetDrawColor(255, 0, 0, 255); // Red eyes for angry look
+    int eyeSize = 3;
+    int eyeY = static_cast<int>(position.y + 6 + walkOffset);
+    
+    SDL_Rect leftEye = {static_cast<int>(position.x + 5), eyeY, eyeSize, eyeSize};
+    SDL_Rect rightEye = {static_cast<int>(position.x + EnemyStore::WIDTH - 8), eyeY, eyeSize, eyeSize};
+    queue.FillRect(leftEye);
+    queue.FillRect(rightEye);
+    
+    // Draw angry eyebrows
+    queue.SetDrawColor(0, 0, 0, 255);
+    if (movingRight) {
+        queue.DrawLine(
+            static_cast<int>(position.x + 4), static_cast<int>(position.y + 4 + walkOffset),
+            static_cast<int>(position.x + 9), static_cast<int>(position.y + 6 + walkOffset));
+        queue.DrawLine(
+            static_cast<int>(position.x + EnemyStore::WIDTH - 9), static_cast<int>(position.y + 4 + walkOffset),
+            static_cast<int>(position.x + EnemyStore::WIDTH - 4), static_cast<int>(position.y + 6 + walkOffset));
+    } else {
+        queue.DrawLine(
+            static_cast<int>(position.x + 9), static_cast<int>(position.y + 4 + walkOffset),
+            static_cast<int>(position.x + 4), static_cast<int>(position.y + 6 + walkOffset));
+        queue.DrawLine(
+            static_cast<int>(position.x + EnemyStore::WIDTH - 4), static_cast<int>(position.y + 4 + walkOffset),
+            static_cast<int>(position.x + EnemyStore::WIDTH - 9), static_cast<int>(position.y + 6 + walkOffset));
+    }
+    
+    // Draw direction indicator (spikes)
+    queue.SetDrawColor(255, 255, 255, 255);
+    int centerY = static_cast<int>(position.y + EnemyStore::HEIGHT/2 + walkOffset);
+    if (movingRight) {
+        queue.DrawLine(
+            static_cast<int>(position.x + EnemyStore::WIDTH - 2), centerY - 3,
+            static_cast<int>(position.x + EnemyStore::WIDTH + 2), centerY);
+        queue.DrawLine(
+            static_cast<int>(position.x + EnemyStore::WIDTH - 2), centerY + 3,
+            static_cast<int>(position.x + EnemyStore::WIDTH + 2), centerY);
+    } else {
+        queue.DrawLine(
+            static_cast<int>(position.x + 2), centerY - 3,
+            static_cast<int>(position.x - 2), centerY);
+        queue.DrawLine(
+            static_cast<int>(position.x + 2), centerY + 3,
+            static_cast<int>(position.x - 2), centerY);
+    }
+}
+
+void EnemyStore::BakeSprites(SpriteAtlas& atlas) {
+    int width = static_cast<int>(WIDTH) + 2 * ENEMY_SPRITE_MARGIN;
+    int height = static_cast<int>(HEIGHT) + 2 * ENEMY_SPRITE_MARGIN;
+    for (int direction = 0; direction < 2; direction++) {
+        bool movingRight = direction == 0;
+        atlas.AddSheet(movingRight ? SpriteSheet::ENEMY_RIGHT : SpriteSheet::ENEMY_LEFT, ENEMY_FRAMES,
+            width, height, ENEMY_SPRITE_MARGIN, ENEMY_SPRITE_MARGIN,
+            [movingRight](RenderQueue& queue, int frame, int x, int y) {
+                float phase = frame * 2.0f * 3.14159265f / ENEMY_FRAMES;
+                DrawEnemy(queue, Vector2(static_cast<float>(x), static_cast<float>(y)), phase, movingRight);
+            });
+    }
+}
+
+void EnemyStore::Render(RenderQueue& queue, const SpriteAtlas& sprites, const Rectangle& view, float alpha) const {
+    queue.SetLayer(RenderLayer::ENEMIES);
+    
+    for (size_t i = 0; i < m_x.size(); i++) {
+        if (!m_isAlive[i]) continue;
+        
+        Vector2 position = Lerp(Vector2(m_previousX[i], m_previousY[i]), Vector2(m_x[i], m_y[i]), alpha);
+        if (!Rectangle(position.x, position.y, WIDTH, HEIGHT).Expand(ENEMY_SPRITE_MARGIN).Intersects(view)) continue;
+        
+        queue.BeginItem();
+        
+        SpriteSheet sheet = m_movingRight[i] ? SpriteSheet::ENEMY_RIGHT : SpriteSheet::ENEMY_LEFT;
+        int frame = SpriteAtlas::PhaseToFrame(m_animationTimer[i], ENEMY_FRAMES);
+        sprites.Draw(queue, sheet, frame, static_cast<int>(position.x), static_cast<int>(position.y));
+    }
+}
\ No newline at end of file
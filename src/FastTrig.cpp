@@ -0,0 +1,98 @@
+#include "FastTrig.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Vectorized part of EvaluateWave(): the same operations as FastSin() in the
+// same order, so every lane matches the scalar result bit for bit. Returns
+// how many values were done.
+#if defined(__AVX2__)
+static size_t EvaluateWaveSimd(const float* phases, size_t count, float frequency, float amplitude, float offset, 
+                               float* values) {
+    const __m256 scale = _mm256_set1_ps(frequency);
+    const __m256 inverseTwoPi = _mm256_set1_ps(0.159154943f);
+    const __m256 twoPiHigh = _mm256_set1_ps(6.28125f);
+    const __m256 twoPiLow = _mm256_set1_ps(0.00193530717958647692f);
+    const __m256 pi = _mm256_set1_ps(3.14159265f);
+    const __m256 minusPi = _mm256_set1_ps(-3.14159265f);
+    const __m256 rounding = _mm256_set1_ps(12582912.0f);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 c3 = _mm256_set1_ps(-1.66666667e-1f);
+    const __m256 c5 = _mm256_set1_ps(8.33333333e-3f);
+    const __m256 c7 = _mm256_set1_ps(-1.98412698e-4f);
+    const __m256 c9 = _mm256_set1_ps(2.75573192e-6f);
+    const __m256 scaleOut = _mm256_set1_ps(amplitude);
+    const __m256 shift = _mm256_set1_ps(offset);
+    
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_mul_ps(_mm256_loadu_ps(&phases[i]), scale);
+        
+        __m256 k = _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(x, inverseTwoPi), rounding), rounding);
+        x = _mm256_sub_ps(_mm256_sub_ps(x, _mm256_mul_ps(k, twoPiHigh)), _mm256_mul_ps(k, twoPiLow));
+        x = _mm256_min_ps(x, _mm256_sub_ps(pi, x));
+        x = _mm256_max_ps(x, _mm256_sub_ps(minusPi, x));
+        
+        __m256 x2 = _mm256_mul_ps(x, x);
+        __m256 p = _mm256_add_ps(c7, _mm256_mul_ps(x2, c9));
+        p = _mm256_add_ps(c5, _mm256_mul_ps(x2, p));
+        p = _mm256_add_ps(c3, _mm256_mul_ps(x2, p));
+        p = _mm256_add_ps(one, _mm256_mul_ps(x2, p));
+        __m256 sine = _mm256_mul_ps(x, p);
+        
+        _mm256_storeu_ps(&values[i], _mm256_add_ps(shift, _mm256_mul_ps(scaleOut, sine)));
+    }
+    return i;
+}
+#elif defined(__SSE2__)
+static size_t EvaluateWaveSimd(const float* phases, size_t count, float frequency, float amplitude, float offset, 
+                               float* values) {
+    const __m128 scale = _mm_set1_ps(frequency);
+    const __m128 inverseTwoPi = _mm_set1_ps(0.159154943f);
+    const __m128 twoPiHigh = _mm_set1_ps(6.28125f);
+    const __m128 twoPiLow = _mm_set1_ps(0.00193530717958647692f);
+    const __m128 pi = _mm_set1_ps(3.14159265f);
+    const __m128 minusPi = _mm_set1_ps(-3.14159265f);
+    const __m128 rounding = _mm_set1_ps(12582912.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 c3 = _mm_set1_ps(-1.66666667e-1f);
+    const __m128 c5 = _mm_set1_ps(8.33333333e-3f);
+    const __m128 c7 = _mm_set1_ps(-1.98412698e-4f);
+    const __m128 c9 = _mm_set1_ps(2.75573192e-6f);
+    const __m128 scaleOut = _mm_set1_ps(amplitude);
+    const __m128 shift = _mm_set1_ps(offset);
+    
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_mul_ps(_mm_loadu_ps(&phases[i]), scale);
+        
+        __m128 k = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(x, inverseTwoPi), rounding), rounding);
+        x = _mm_sub_ps(_mm_sub_ps(x, _mm_mul_ps(k, twoPiHigh)), _mm_mul_ps(k, twoPiLow));
+        x = _mm_min_ps(x, _mm_sub_ps(pi, x));
+        x = _mm_max_ps(x, _mm_sub_ps(minusPi, x));
+        
+        __m128 x2 = _mm_mul_ps(x, x);
+        __m128 p = _mm_add_ps(c7, _mm_mul_ps(x2, c9));
+        p = _mm_add_ps(c5, _mm_mul_ps(x2, p));
+        p = _mm_add_ps(c3, _mm_mul_ps(x2, p));
+        p = _mm_add_ps(one, _mm_mul_ps(x2, p));
+        __m128 sine = _mm_mul_ps(x, p);
+        
+        _mm_storeu_ps(&values[i], _mm_add_ps(shift, _mm_mul_ps(scaleOut, sine)));
+    }
+    return i;
+}
+#else
+static size_t EvaluateWaveSimd(const float*, size_t, float, float, float, float*) {
+    return 0; // No vector unit available - the scalar loop handles everything
+}
+#endif
+
+void EvaluateWave(const float* phases, size_t count, float frequency, float amplitude, float offset, float* values) {
+    for (size_t i = EvaluateWaveSimd(phases, count, frequency, amplitude, offset, values); i < count; i++) {
+        values[i] = offset + amplitude * FastSin(phases[i] * frequency);
+    }
+}
\ No newline at end of file
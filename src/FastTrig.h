@@ -0,0 +1,42 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+
+// Polynomial sine and cosine for animation and effects. They stay within
+// 4e-6 of the exact value for any argument a game timer reaches, need no libm
+// call and have no branches, and do not depend on the platform's libm. The
+// vector and scalar paths of EvaluateWave() give identical results.
+
+// x minus the multiple of 2 pi that brings it into [-pi, pi]
+inline float WrapAngle(float x) {
+    const float inverseTwoPi = 0.159154943f;
+    const float twoPiHigh = 6.28125f;                // 2 pi split in two so that k * 2 pi
+    const float twoPiLow = 0.00193530717958647692f;  // is subtracted without rounding error
+    const float rounding = 12582912.0f;              // 1.5 * 2^23: adding it rounds to an integer
+    
+    float k = (x * inverseTwoPi + rounding) - rounding;
+    return (x - k * twoPiHigh) - k * twoPiLow;
+}
+
+inline float FastSin(float x) {
+    const float pi = 3.14159265f;
+    
+    // Fold onto [-pi/2, pi/2], where sin is odd and monotonic
+    x = WrapAngle(x);
+    x = std::min(x, pi - x);
+    x = std::max(x, -pi - x);
+    
+    // Taylor series to x^9
+    float x2 = x * x;
+    return x * (1.0f + x2 * (-1.66666667e-1f + x2 * (8.33333333e-3f + x2 * (-1.98412698e-4f + x2 * 2.75573192e-6f))));
+}
+
+// Wrapped before the quarter turn is added, which would round away precision of a large x
+inline float FastCos(float x) {
+    return FastSin(WrapAngle(x) + 1.57079633f);
+}
+
+// values[i] = offset + amplitude * FastSin(phases[i] * frequency) for a whole
+// column of per-entity animation phases in one pass, eight or four at a time
+// with AVX2 or SSE2. values may be the same array as phases.
+void EvaluateWave(const float* phases, size_t count, float frequency, float amplitude, float offset, float* values);
\ No newline at end of file
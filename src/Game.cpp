@@ -1,4 +1,5 @@
 #include "Game.h"
+#include "World.h"
 #include "Player.h"
 #include "Platform.h"
 #include "Enemy.h"
@@ -7,20 +8,43 @@
 #include "PowerUp.h"
 #include "ParticleSystem.h"
 #include <iostream>
+#include <fstream>
 #include <sstream>
 #include <cmath>
+#include <cstdio>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <thread>
 
-const float Game::GRAVITY = 800.0f; // pixels per second squared
+const float Game::MAX_FRAME_TIME = 0.25f; // Longest frame fed to the accumulator (avoids spiral of death)
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+static const bool SIMULATION_THREAD_AVAILABLE = false;
+#else
+static const bool SIMULATION_THREAD_AVAILABLE = true;
+#endif
+
+// Zones recorded by the simulation rather than the render loop
+static bool IsSimulationZone(ProfileZone zone) {
+    return zone >= ProfileZone::UPDATE && zone <= ProfileZone::PICKUPS;
+}
 
 Game::Game() : m_window(nullptr), m_renderer(nullptr), m_font(nullptr), m_smallFont(nullptr), 
-               m_isRunning(false), m_gameState(GameState::MENU), m_selectedMenuOption(MenuOption::PLAY), 
-               m_score(0), m_lives(3), m_level(1), 
-               m_levelTime(0.0f), m_lastFrameTime(0), m_deltaTime(0.0f) {
+               m_isRunning(false), m_showProfiler(false), m_world(std::make_unique<World>()), 
+               m_useSimulationThread(SIMULATION_THREAD_AVAILABLE), 
+               m_gameState(GameState::MENU), m_selectedMenuOption(MenuOption::PLAY), 
+               m_lastFrameCounter(0), m_accumulator(0.0), 
+               m_deltaTime(1.0f / 60.0f), 
+               m_isRecording(false), m_isReplaying(false), m_restartPending(false), m_replayTick(0), 
+               m_levelFile(nullptr), m_continuePending(false) {
     // Initialize input arrays
     for (int i = 0; i < SDL_NUM_SCANCODES; i++) {
         m_keys[i] = false;
         m_keysPressed[i] = false;
     }
+    
+    m_world->SetProfiler(&m_simulationProfiler);
 }
 
 Game::~Game() {
@@ -54,14 +78,21 @@ bool Game::Initialize() {
     }
     
     // Create renderer
-    m_renderer = SDL_CreateRenderer(m_window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    m_renderer = SDL_CreateRenderer(m_window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE);
     if (!m_renderer) {
         std::cerr << "Renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
         return false;
     }
     
-    // Initialize particle system
-    m_particleSystem = std::make_unique<ParticleSystem>();
+    // Bake the procedurally drawn entities into one sprite texture
+    CoinStore::BakeSprites(m_sprites);
+    PowerUpStore::BakeSprites(m_sprites);
+    EnemyStore::BakeSprites(m_sprites);
+    Player::BakeSprites(m_sprites);
+    if (!m_sprites.Build(m_renderer)) {
+        std::cerr << "Warning: Could not build sprite atlas! SDL_Error: " << SDL_GetError() << std::endl;
+        std::cerr << "Entities will be drawn from primitives." << std::endl;
+    }
     
     // Load fonts - try bundled font first, then system fonts as fallback
     const char* fontPaths[] = {
@@ -104,161 +135,277 @@ bool Game::Initialize() {
         m_smallFont = TTF_OpenFont(fontPaths[i], smallFontSize);
     }
     
-    // Start with menu
+    // Render each font's glyphs once so text never needs a texture per string
+    if (m_font && !m_text.Build(m_renderer, m_font)) {
+        std::cerr << "Warning: Could not build glyph atlas! SDL_Error: " << SDL_GetError() << std::endl;
+    }
+    if (m_smallFont) {
+        m_smallText.Build(m_renderer, m_smallFont);
+    }
+    
+    // Start with menu, or straight into the recorded session
     m_gameState = GameState::MENU;
+    if (m_isReplaying) {
+        ResetGame();
+        m_gameState = GameState::PLAYING;
+    }
     
     m_isRunning = true;
-    m_lastFrameTime = SDL_GetTicks();
+    m_lastFrameCounter = SDL_GetPerformanceCounter();
+    m_accumulator = 0.0;
     
     return true;
 }
 
 void Game::ResetGame() {
-    // Clear all game objects
-    m_platforms.clear();
-    m_movingPlatforms.clear();
-    m_enemies.clear();
-    m_coins.clear();
-    m_powerUps.clear();
-    
-    // Reset game state
-    m_score = 0;
-    m_lives = 3;
-    m_level = 1;
-    m_levelTime = 0.0f;
-    
-    // Initialize player
-    m_player = std::make_unique<Player>(50, WINDOW_HEIGHT - 100);
-    
-    // Create level 1 - Balanced and achievable design
-    // Ground platform
-    m_platforms.push_back(std::make_unique<Platform>(0, WINDOW_HEIGHT - 50, WINDOW_WIDTH, 50));
-    
-    // Static platforms - arranged as stepping stones with reasonable gaps
-    m_platforms.push_back(std::make_unique<Platform>(150, WINDOW_HEIGHT - 120, 120, 20));    // Low platform
-    m_platforms.push_back(std::make_unique<Platform>(320, WINDOW_HEIGHT - 180, 120, 20));    // Medium platform
-    m_platforms.push_back(std::make_unique<Platform>(500, WINDOW_HEIGHT - 240, 120, 20));    // Higher platform
-    m_platforms.push_back(std::make_unique<Platform>(680, WINDOW_HEIGHT - 180, 120, 20));    // Back down
-    m_platforms.push_back(std::make_unique<Platform>(850, WINDOW_HEIGHT - 140, 120, 20));    // Final platform
-    
-    // Additional platforms for easier navigation
-    m_platforms.push_back(std::make_unique<Platform>(50, WINDOW_HEIGHT - 200, 80, 15));      // Helper platform
-    m_platforms.push_back(std::make_unique<Platform>(400, WINDOW_HEIGHT - 120, 80, 15));     // Helper platform
-    m_platforms.push_back(std::make_unique<Platform>(750, WINDOW_HEIGHT - 120, 80, 15));     // Helper platform
-    
-    // Moving platforms - positioned to help reach higher areas
-    m_movingPlatforms.push_back(std::make_unique<MovingPlatform>(250, WINDOW_HEIGHT - 140, 60, 12, MovementType::HORIZONTAL, 40, 60));
-    m_movingPlatforms.push_back(std::make_unique<MovingPlatform>(550, WINDOW_HEIGHT - 200, 60, 12, MovementType::VERTICAL, 30, 40));
-    m_movingPlatforms.push_back(std::make_unique<MovingPlatform>(780, WINDOW_HEIGHT - 200, 50, 12, MovementType::HORIZONTAL, 35, 50));
-    
-    // Enemies - placed strategically but not blocking essential paths
-    m_enemies.push_back(std::make_unique<Enemy>(200, WINDOW_HEIGHT - 100));
-    m_enemies.push_back(std::make_unique<Enemy>(450, WINDOW_HEIGHT - 100));
-    m_enemies.push_back(std::make_unique<Enemy>(700, WINDOW_HEIGHT - 100));
-    m_enemies.push_back(std::make_unique<Enemy>(350, WINDOW_HEIGHT - 210));
-    
-    // Coins - placed near platforms and reachable with normal jumps
-    m_coins.push_back(std::make_unique<Coin>(200, WINDOW_HEIGHT - 150));    // On first platform
-    m_coins.push_back(std::make_unique<Coin>(370, WINDOW_HEIGHT - 210));    // On second platform  
-    m_coins.push_back(std::make_unique<Coin>(550, WINDOW_HEIGHT - 270));    // On third platform
-    m_coins.push_back(std::make_unique<Coin>(730, WINDOW_HEIGHT - 210));    // On fourth platform
-    m_coins.push_back(std::make_unique<Coin>(900, WINDOW_HEIGHT - 170));    // On final platform
-    m_coins.push_back(std::make_unique<Coin>(100, WINDOW_HEIGHT - 230));    // On helper platform
-    m_coins.push_back(std::make_unique<Coin>(450, WINDOW_HEIGHT - 150));    // On helper platform
-    m_coins.push_back(std::make_unique<Coin>(800, WINDOW_HEIGHT - 150));    // On helper platform
-    m_coins.push_back(std::make_unique<Coin>(300, WINDOW_HEIGHT - 100));    // Ground level coin
-    m_coins.push_back(std::make_unique<Coin>(600, WINDOW_HEIGHT - 100));    // Ground level coin
-    
-    // Power-ups - placed on accessible platforms
-    m_powerUps.push_back(std::make_unique<PowerUp>(370, WINDOW_HEIGHT - 220, PowerUpType::SUPER_MARIO));    // On second platform
-    m_powerUps.push_back(std::make_unique<PowerUp>(100, WINDOW_HEIGHT - 240, PowerUpType::SPEED_BOOST));    // On helper platform
-    m_powerUps.push_back(std::make_unique<PowerUp>(900, WINDOW_HEIGHT - 180, PowerUpType::EXTRA_LIFE));     // On final platform
-}
-
-void Game::NextLevel() {
-    m_level++;
-    
-    // Clear current level objects
-    m_platforms.clear();
-    m_movingPlatforms.clear();
-    m_enemies.clear();
-    m_coins.clear();
-    m_powerUps.clear();
-    
-    // Reset player position
-    m_player->SetPosition(Vector2(50, WINDOW_HEIGHT - 100));
-    m_levelTime = 0.0f;
-    
-    // Create more challenging level
-    m_platforms.push_back(std::make_unique<Platform>(0, WINDOW_HEIGHT - 50, WINDOW_WIDTH, 50));
-    
-    // More complex platform layout
-    for (int i = 0; i < 8; i++) {
-        float x = 100 + i * 120;
-        float y = WINDOW_HEIGHT - 150 - (i % 3) * 100;
-        m_platforms.push_back(std::make_unique<Platform>(x, y, 80, 15));
-    }
-    
-    // More moving platforms
-    for (int i = 0; i < 4; i++) {
-        MovementType type = static_cast<MovementType>(i % 3);
-        float x = 200 + i * 200;
-        float y = WINDOW_HEIGHT - 200 - i * 50;
-        m_movingPlatforms.push_back(std::make_unique<MovingPlatform>(x, y, 60, 12, type, 50 + i * 20, 80));
-    }
-    
-    // More enemies
-    for (int i = 0; i < m_level + 3; i++) {
-        float x = 150 + i * 120;
-        float y = WINDOW_HEIGHT - 100;
-        m_enemies.push_back(std::make_unique<Enemy>(x, y));
-    }
-    
-    // More coins
-    for (int i = 0; i < 12; i++) {
-        float x = 80 + i * 80;
-        float y = WINDOW_HEIGHT - 120 - (i % 4) * 80;
-        m_coins.push_back(std::make_unique<Coin>(x, y));
-    }
-    
-    // More power-ups
-    m_powerUps.push_back(std::make_unique<PowerUp>(300, WINDOW_HEIGHT - 280, PowerUpType::SUPER_MARIO));
-    m_powerUps.push_back(std::make_unique<PowerUp>(600, WINDOW_HEIGHT - 350, PowerUpType::SPEED_BOOST));
-    m_powerUps.push_back(std::make_unique<PowerUp>(800, WINDOW_HEIGHT - 200, PowerUpType::EXTRA_LIFE));
+    if (m_isReplaying) {
+        m_replayTick = 0;
+        m_world->SetSeed(m_recording.GetSeed());
+        m_world->Reset(m_recording.GetStartLevel());
+        m_world->SaveState(m_startState);
+        return;
+    }
+    
+    if (m_isRecording) {
+        // Each session gets a fresh seed that the recording carries along
+        SaveRecording();
+        std::uint32_t seed = std::random_device()();
+        int tickRate = static_cast<int>(std::lround(1.0f / m_deltaTime));
+        m_recording.Begin(tickRate, seed, 1);
+        m_restartPending = false;
+        m_world->SetSeed(seed);
+    }
+    
+    if (m_scenario) {
+        m_world->LoadScenario(*m_scenario);
+    } else if (m_levelFile) {
+        m_world->LoadLevel(*m_levelFile);
+    } else {
+        m_world->Reset();
+    }
+    m_world->SaveState(m_startState);
+}
+
+void Game::RestartLevel() {
+    // Replays restart where the recording says so, not on key presses
+    if (m_isReplaying) return;
+    
+    m_world->LoadState(m_startState);
+    m_restartPending = m_isRecording;
+}
+
+void Game::ContinueSavedGame() {
+    m_continuePending = false;
+    
+    std::ifstream file(m_savePath, std::ios::binary);
+    if (!file) return;
+    std::vector<std::uint8_t> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (m_world->LoadState(image)) {
+        std::cout << "Continuing the game saved in " << m_savePath << std::endl;
+    } else {
+        // A damaged image may have got as far as tearing the level down
+        std::cerr << "Could not continue from " << m_savePath << ", starting a new game" << std::endl;
+        ResetGame();
+    }
+}
+
+void Game::SaveGame() {
+    if (m_savePath.empty()) return;
+    
+    bool isMidGame = m_gameState == GameState::PLAYING || m_gameState == GameState::PAUSED;
+    if (!isMidGame) {
+        // Keep a save that was never continued; one that was played to the end is done with
+        if (!m_continuePending) {
+            std::remove(m_savePath.c_str());
+        }
+        return;
+    }
+    
+    std::vector<std::uint8_t> image;
+    m_world->SaveState(image);
+    std::ofstream file(m_savePath, std::ios::binary);
+    if (!file.write(reinterpret_cast<const char*>(image.data()), image.size())) {
+        std::cerr << "Could not save the game to " << m_savePath << std::endl;
+    }
+}
+
+void Game::SetRecordPath(const std::string& path) {
+    m_recordPath = path;
+    m_isRecording = !path.empty();
+    m_isReplaying = false;
+}
+
+void Game::SetReplay(const InputRecording& recording) {
+    m_recording = recording;
+    m_isReplaying = true;
+    m_isRecording = false;
+    m_replayTick = 0;
+    SetTickRate(recording.GetTickRate());
+}
+
+void Game::SetScenario(const LevelLayout& layout) {
+    m_scenario = std::make_unique<LevelLayout>(layout);
+}
+
+void Game::SetLevelFile(const LevelFile* file) {
+    m_levelFile = file;
+}
+
+void Game::SetSavePath(const std::string& path) {
+    m_savePath = path;
+    m_continuePending = !path.empty();
+}
+
+void Game::SetJobSystem(JobSystem* jobs) {
+    m_world->SetJobSystem(jobs);
+}
+
+void Game::SetSimulationThread(bool enabled) {
+    m_useSimulationThread = enabled && SIMULATION_THREAD_AVAILABLE;
+}
+
+void Game::SaveRecording() {
+    if (!m_isRecording || m_recording.GetTickCount() == 0) return;
+    
+    if (m_recording.Save(m_recordPath)) {
+        std::cout << "Recorded " << m_recording.GetTickCount() << " ticks to " << m_recordPath << std::endl;
+    } else {
+        std::cerr << "Could not write input recording to " << m_recordPath << std::endl;
+    }
+    m_recording.Clear();
+}
+
+void Game::FinishReplay() {
+    std::cout << "Replay finished: " << m_recording.GetTickCount() << " ticks, level " << m_world->GetLevel()
+              << ", score " << m_world->GetScore() << ", lives " << m_world->GetLives() << std::endl;
+    std::cout << "  State hash: " << std::hex << m_world->ComputeStateHash() << std::dec << std::endl;
+    m_simulationProfiler.PrintSummary(std::cout);
+    
+    m_gameState = GameState::GAME_OVER;
+    m_isRunning = false;
+}
+
+void Game::SetTickRate(int ticksPerSecond) {
+    if (ticksPerSecond <= 0) return;
+    m_deltaTime = 1.0f / static_cast<float>(ticksPerSecond);
 }
 
 void Game::Run() {
+    // SDL wants events and rendering on the thread that created the window, so
+    // this thread renders and presents while the simulation ticks on its own.
+    // A present blocked on vblank then no longer holds up the next tick.
+    std::thread simulation;
+    if (m_useSimulationThread) {
+        simulation = std::thread(&Game::RunSimulation, this);
+    }
+    
     while (m_isRunning) {
-        // Calculate delta time
-        Uint32 currentTime = SDL_GetTicks();
-        m_deltaTime = (currentTime - m_lastFrameTime) / 1000.0f;
-        m_lastFrameTime = currentTime;
+        m_profiler.BeginFrame();
+        
+        {
+            ProfileScope scope(&m_profiler, ProfileZone::EVENTS);
+            std::lock_guard<std::mutex> lock(m_simulationMutex);
+            HandleEvents();
+        }
         
-        // Cap delta time to prevent large jumps
-        if (m_deltaTime > 0.016f) {
-            m_deltaTime = 0.016f;
+        // Without a simulation thread the ticks run between events and rendering
+        if (!m_useSimulationThread) {
+            std::lock_guard<std::mutex> lock(m_simulationMutex);
+            AdvanceSimulation();
         }
         
-        HandleEvents();
-        Update();
         Render();
+        
+        m_profiler.EndFrame();
+    }
+    
+    if (simulation.joinable()) {
+        simulation.join();
+    }
+}
+
+void Game::RunSimulation() {
+    while (m_isRunning) {
+        double untilNextTick;
+        {
+            std::lock_guard<std::mutex> lock(m_simulationMutex);
+            AdvanceSimulation();
+            untilNextTick = m_deltaTime - m_accumulator;
+        }
+        
+        // Sleep instead of spinning; the accumulator absorbs oversleeping
+        std::this_thread::sleep_for(std::chrono::duration<double>(untilNextTick));
+    }
+}
+
+void Game::AdvanceSimulation() {
+    // Measure real time since the last call with the high-resolution counter
+    Uint64 currentCounter = SDL_GetPerformanceCounter();
+    double frameTime = (currentCounter - m_lastFrameCounter) / static_cast<double>(SDL_GetPerformanceFrequency());
+    m_lastFrameCounter = currentCounter;
+    
+    // Clamp long frames (window drag, breakpoints) so we never try to catch up forever
+    if (frameTime > MAX_FRAME_TIME) {
+        frameTime = MAX_FRAME_TIME;
+    }
+    m_accumulator += frameTime;
+    
+    // Advance the simulation in fixed steps, independent of the display rate
+    m_simulationProfiler.BeginFrame();
+    {
+        ProfileScope scope(&m_simulationProfiler, ProfileZone::UPDATE);
+        while (m_accumulator >= m_deltaTime) {
+            Update();
+            m_accumulator -= m_deltaTime;
+            
+            // Key presses are consumed by the first tick that sees them
+            for (int i = 0; i < SDL_NUM_SCANCODES; i++) {
+                m_keysPressed[i] = false;
+            }
+        }
     }
+    m_simulationProfiler.EndFrame();
+    
+    PublishFrame(currentCounter);
+}
+
+void Game::PublishFrame(Uint64 counter) {
+    Frame& frame = m_frames.GetBack();
+    frame.world.Capture(*m_world);
+    frame.state = m_gameState;
+    frame.counter = counter;
+    frame.accumulator = m_accumulator;
+    m_frames.Publish();
 }
 
 void Game::HandleEvents() {
     SDL_Event e;
     
-    // Reset pressed keys
-    for (int i = 0; i < SDL_NUM_SCANCODES; i++) {
-        m_keysPressed[i] = false;
-    }
-    
     while (SDL_PollEvent(&e) != 0) {
         if (e.type == SDL_QUIT) {
             m_isRunning = false;
+        } else if (e.type == SDL_WINDOWEVENT && e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+            m_background.Invalidate();
+        } else if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET) {
+            // Cached render-target contents were lost
+            m_background.Invalidate();
+            m_staticLayer.Invalidate();
         } else if (e.type == SDL_KEYDOWN && !e.key.repeat) {
             m_keysPressed[e.key.keysym.scancode] = true;
             
+            // Profiler controls work in every state
+            if (e.key.keysym.scancode == SDL_SCANCODE_F1) {
+                m_showProfiler = !m_showProfiler;
+            } else if (e.key.keysym.scancode == SDL_SCANCODE_F2) {
+                std::string name = "profile_" + std::to_string(SDL_GetTicks());
+                if (m_profiler.WriteCsv(name + ".csv") && m_simulationProfiler.WriteCsv(name + "_simulation.csv")) {
+                    std::cout << "Wrote " << m_profiler.GetHistorySize() << " frames to " << name << ".csv and "
+                              << name << "_simulation.csv" << std::endl;
+                } else {
+                    std::cerr << "Could not write profile to " << name << ".csv" << std::endl;
+                }
+            }
+            
             // Menu controls
             if (m_gameState == GameState::MENU) {
                 if (e.key.keysym.scancode == SDL_SCANCODE_UP || 
@@ -271,6 +418,9 @@ void Game::HandleEvents() {
                            e.key.keysym.scancode == SDL_SCANCODE_RETURN) {
                     if (m_selectedMenuOption == MenuOption::PLAY) {
                         ResetGame();
+                        if (m_continuePending) {
+                            ContinueSavedGame();
+                        }
                         m_gameState = GameState::PLAYING;
                     } else if (m_selectedMenuOption == MenuOption::INSTRUCTIONS) {
                         m_gameState = GameState::INSTRUCTIONS;
@@ -291,7 +441,7 @@ void Game::HandleEvents() {
                 if (e.key.keysym.scancode == SDL_SCANCODE_ESCAPE) {
                     m_gameState = GameState::PAUSED;
                 } else if (e.key.keysym.scancode == SDL_SCANCODE_R) {
-                    ResetGame();
+                    RestartLevel();
                 }
             } else if (m_gameState == GameState::PAUSED) {
                 if (e.key.keysym.scancode == SDL_SCANCODE_ESCAPE) {
@@ -306,357 +456,258 @@ void Game::HandleEvents() {
     for (int i = 0; i < SDL_NUM_SCANCODES; i++) {
         m_keys[i] = keystate[i];
     }
-    
-    // Handle player input only when playing - use direct SDL keystate for maximum reliability
-    if (m_gameState == GameState::PLAYING && m_player) {
-        const Uint8* directKeystate = SDL_GetKeyboardState(NULL);
-        m_player->HandleInputSimple(directKeystate);
-    }
+}
+
+PlayerInput Game::ReadPlayerInput() const {
+    // Key states as of the last HandleEvents(); SDL's own may only be read
+    // on the thread that pumps the events
+    PlayerInput input;
+    input.left = m_keys[SDL_SCANCODE_LEFT] || m_keys[SDL_SCANCODE_A];
+    input.right = m_keys[SDL_SCANCODE_RIGHT] || m_keys[SDL_SCANCODE_D];
+    input.jump = m_keys[SDL_SCANCODE_UP] || m_keys[SDL_SCANCODE_W] || m_keys[SDL_SCANCODE_SPACE];
+    input.jumpPressed = m_keysPressed[SDL_SCANCODE_SPACE] || m_keysPressed[SDL_SCANCODE_UP] || m_keysPressed[SDL_SCANCODE_W];
+    return input;
 }
 
 void Game::Update() {
-    if (m_gameState != GameState::PLAYING || !m_player) return;
-    
-    m_levelTime += m_deltaTime;
-    
-    // Update player
-    m_player->Update(m_deltaTime);
-    
-    // Update moving platforms
-    for (auto& platform : m_movingPlatforms) {
-        platform->Update(m_deltaTime);
-    }
+    if (m_gameState != GameState::PLAYING) return;
     
-    // Update enemies
-    for (auto& enemy : m_enemies) {
-        if (enemy->IsAlive()) {
-            enemy->Update(m_deltaTime, m_platforms);
-            enemy->SetOnGround(false);
+    PlayerInput input;
+    if (m_isReplaying) {
+        if (m_replayTick >= m_recording.GetTickCount()) {
+            FinishReplay();
+            return;
+        }
+        if (m_recording.IsRestart(m_replayTick)) {
+            m_world->LoadState(m_startState);
+        }
+        input = m_recording.GetInput(m_replayTick++);
+    } else {
+        input = ReadPlayerInput();
+        if (m_isRecording) {
+            m_recording.AddTick(input, m_restartPending);
+            m_restartPending = false;
         }
     }
     
-    // Update coins
-    for (auto& coin : m_coins) {
-        coin->Update(m_deltaTime);
-    }
-    
-    // Update power-ups
-    for (auto& powerUp : m_powerUps) {
-        powerUp->Update(m_deltaTime);
-    }
-    
-    // Update particle system
-    m_particleSystem->Update(m_deltaTime);
-    
-    // Platform collisions for player
-    Rectangle playerBounds = m_player->GetBounds();
-    m_player->SetOnGround(false);
+    m_world->Step(m_deltaTime, input);
     
-    // Static platforms
-    for (const auto& platform : m_platforms) {
-        Rectangle platformBounds = platform->GetBounds();
-        if (playerBounds.Intersects(platformBounds)) {
-            m_player->ResolveCollision(platformBounds);
+    if (m_world->IsGameOver()) {
+        m_gameState = GameState::GAME_OVER;
+        if (m_isReplaying) {
+            FinishReplay();
+        } else {
+            SaveRecording();
         }
     }
+}
+
+void Game::Render() {
+    m_frames.Acquire();
+    const Frame& frame = m_frames.GetFront();
+    const WorldSnapshot& world = frame.world;
     
-    // Moving platforms (with velocity transfer)
-    for (const auto& platform : m_movingPlatforms) {
-        Rectangle platformBounds = platform->GetBounds();
-        if (playerBounds.Intersects(platformBounds)) {
-            m_player->ResolveCollision(platformBounds);
-            
-            // Transfer platform velocity to player when on top
-            if (m_player->IsOnGround()) {
-                Vector2 platformVel = platform->GetVelocity();
-                Vector2 newPos = m_player->GetPosition() + Vector2(platformVel.x * m_deltaTime, 0);
-                m_player->SetPosition(newPos);
-            }
-        }
+    // Render between the frame's last two ticks, as far along as the clock has
+    // moved since, and only interpolate while the simulation is actually ticking
+    float alpha = 1.0f;
+    if (frame.state == GameState::PLAYING) {
+        double elapsed = (SDL_GetPerformanceCounter() - frame.counter) / static_cast<double>(SDL_GetPerformanceFrequency());
+        alpha = static_cast<float>(std::min(1.0, (frame.accumulator + elapsed) / m_deltaTime));
     }
     
-    // Enemy platform collisions
-    for (auto& enemy : m_enemies) {
-        if (!enemy->IsAlive()) continue;
+    {
+        ProfileScope scope(&m_profiler, ProfileZone::RENDER_BACKGROUND);
         
-        Rectangle enemyBounds = enemy->GetBounds();
-        
-        // Static platforms
-        for (const auto& platform : m_platforms) {
-            Rectangle platformBounds = platform->GetBounds();
-            if (enemyBounds.Intersects(platformBounds)) {
-                enemy->ResolveCollision(platformBounds);
-            }
-        }
+        // Clear screen with sky color
+        SDL_SetRenderDrawColor(m_renderer, 135, 206, 235, 255);
+        SDL_RenderClear(m_renderer);
         
-        // Moving platforms
-        for (const auto& platform : m_movingPlatforms) {
-            Rectangle platformBounds = platform->GetBounds();
-            if (enemyBounds.Intersects(platformBounds)) {
-                enemy->ResolveCollision(platformBounds);
-            }
-        }
-    }
-    
-    // Coin collection
-    for (auto& coin : m_coins) {
-        if (!coin->IsCollected() && playerBounds.Intersects(coin->GetBounds())) {
-            coin->Collect();
-            m_score += coin->GetValue();
-            m_particleSystem->CreateCoinEffect(coin->GetBounds().Center());
-        }
+        // Sky and scenery layers are cached and only redrawn on resize or level change;
+        // they scroll with the camera at their own parallax rate
+        bool showWorld = frame.state == GameState::PLAYING || frame.state == GameState::PAUSED;
+        float cameraX = showWorld ? world.camera.GetInterpolatedX(alpha) : 0.0f;
+        m_background.Render(m_renderer, WINDOW_WIDTH, WINDOW_HEIGHT, world.level, cameraX);
     }
     
-    // Power-up collection
-    for (auto& powerUp : m_powerUps) {
-        if (!powerUp->IsCollected() && playerBounds.Intersects(powerUp->GetBounds())) {
-            powerUp->Collect();
-            m_particleSystem->CreatePowerUpEffect(powerUp->GetBounds().Center());
-            
-            switch (powerUp->GetType()) {
-                case PowerUpType::SUPER_MARIO:
-                    m_player->SetPoweredUp(true);
-                    m_score += 200;
-                    break;
-                case PowerUpType::SPEED_BOOST:
-                    m_score += 150;
-                    break;
-                case PowerUpType::EXTRA_LIFE:
-                    m_lives++;
-                    m_score += 500;
-                    break;
-            }
-        }
+    // Menu screens have no world behind them
+    if (frame.state == GameState::PLAYING || frame.state == GameState::PAUSED) {
+        RenderWorld(world, alpha);
     }
     
-    // Enemy-player collisions
-    for (auto& enemy : m_enemies) {
-        if (enemy->IsAlive() && playerBounds.Intersects(enemy->GetBounds())) {
-            Vector2 playerPos = m_player->GetPosition();
-            Vector2 enemyPos = Vector2(enemy->GetBounds().x, enemy->GetBounds().y);
+    {
+        ProfileScope scope(&m_profiler, ProfileZone::RENDER_UI);
+        
+        if (frame.state == GameState::MENU) {
+            RenderMenu();
+        } else if (frame.state == GameState::INSTRUCTIONS) {
+            RenderInstructions();
+        } else if (frame.state == GameState::GAME_OVER) {
+            RenderGameOver(world);
+        } else {
+            RenderUI(world);
             
-            if (playerPos.y < enemyPos.y - 10 && !m_player->IsInvulnerable()) {
-                // Player stomped enemy
-                enemy->Kill();
-                m_score += 150;
-                m_particleSystem->CreateExplosion(enemy->GetBounds().Center(), Color(139, 0, 0));
+            if (frame.state == GameState::PAUSED) {
+                // Draw the queued UI text before the overlay covers it
+                m_renderQueue.Submit(m_renderer);
                 
-                // Small bounce
-                Vector2 bouncePos = Vector2(playerPos.x, playerPos.y - 5);
-                m_player->SetPosition(bouncePos);
-            } else if (!m_player->IsInvulnerable()) {
-                // Player hit by enemy
-                if (m_player->IsPoweredUp()) {
-                    m_player->SetPoweredUp(false);
-                    m_player->SetInvulnerable(2.0f);
-                } else {
-                    m_lives--;
-                    m_player->SetInvulnerable(2.0f);
-                    if (m_lives <= 0) {
-                        m_gameState = GameState::GAME_OVER;
-                    } else {
-                        // Reset position
-                        m_player->SetPosition(Vector2(50, WINDOW_HEIGHT - 100));
-                    }
-                }
+                // Render pause overlay
+                SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 128);
+                SDL_Rect overlay = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+                SDL_RenderFillRect(m_renderer, &overlay);
+                
+                // Pause text
+                RenderTextCentered("PAUSED", WINDOW_HEIGHT/2 - 50, {255, 255, 255, 255});
+                RenderTextCentered("Press ESC to resume", WINDOW_HEIGHT/2 - 10, {255, 255, 255, 255});
+                RenderTextCentered("Press R to restart level", WINDOW_HEIGHT/2 + 30, {255, 255, 255, 255});
             }
         }
-    }
-    
-    // Check for level completion (all coins collected)
-    bool allCoinsCollected = true;
-    for (const auto& coin : m_coins) {
-        if (!coin->IsCollected()) {
-            allCoinsCollected = false;
-            break;
-        }
-    }
-    
-    if (allCoinsCollected) {
-        NextLevel();
-        m_score += 1000 * m_level; // Bonus for completing level
-    }
-    
-    // Keep player in bounds
-    Vector2 playerPos = m_player->GetPosition();
-    if (playerPos.x < 0) {
-        m_player->SetPosition(Vector2(0, playerPos.y));
-    } else if (playerPos.x > WINDOW_WIDTH - 30) {
-        m_player->SetPosition(Vector2(WINDOW_WIDTH - 30, playerPos.y));
-    }
-    
-    // Check if player fell off screen
-    if (playerPos.y > WINDOW_HEIGHT) {
-        m_lives--;
-        if (m_lives <= 0) {
-            m_gameState = GameState::GAME_OVER;
-        } else {
-            m_player->SetPosition(Vector2(50, WINDOW_HEIGHT - 100));
+        
+        // Text and the menu screens' demo particles are recorded into the queue
+        m_renderQueue.Submit(m_renderer);
+        
+        if (m_showProfiler) {
+            RenderProfilerOverlay(world);
+            m_renderQueue.Submit(m_renderer);
         }
     }
     
-    // Add jump effect particles when jump keys are pressed and player is on ground
-    if ((m_keysPressed[SDL_SCANCODE_SPACE] || m_keysPressed[SDL_SCANCODE_UP] || m_keysPressed[SDL_SCANCODE_W]) && 
-        m_player->IsOnGround()) {
-        m_particleSystem->CreateJumpEffect(Vector2(playerPos.x + 15, playerPos.y + 30));
-    }
+    ProfileScope scope(&m_profiler, ProfileZone::PRESENT);
+    SDL_RenderPresent(m_renderer);
 }
 
-void Game::Render() {
-    // Clear screen with gradient sky
-    SDL_SetRenderDrawColor(m_renderer, 135, 206, 235, 255);
-    SDL_RenderClear(m_renderer);
-    
-    // Render gradient background
-    for (int y = 0; y < WINDOW_HEIGHT/2; y++) {
-        Uint8 r = 135 + (120 * y) / (WINDOW_HEIGHT/2);
-        Uint8 g = 206 + (49 * y) / (WINDOW_HEIGHT/2);
-        Uint8 b = 235 + (20 * y) / (WINDOW_HEIGHT/2);
-        SDL_SetRenderDrawColor(m_renderer, r, g, b, 255);
-        SDL_RenderDrawLine(m_renderer, 0, y, WINDOW_WIDTH, y);
-    }
-    
-    if (m_gameState == GameState::MENU) {
-        RenderMenu();
-    } else if (m_gameState == GameState::INSTRUCTIONS) {
-        RenderInstructions();
-    } else if (m_gameState == GameState::GAME_OVER) {
-        RenderGameOver();
-    } else {
-        // Render game objects
-        for (const auto& platform : m_platforms) {
-            platform->Render(m_renderer);
-        }
+void Game::RenderWorld(const WorldSnapshot& world, float alpha) {
+    {
+        ProfileScope scope(&m_profiler, ProfileZone::RENDER_WORLD);
         
-        for (const auto& platform : m_movingPlatforms) {
-            platform->Render(m_renderer);
-        }
+        // Everything in the world is recorded in world coordinates relative to the camera
+        int cameraX = static_cast<int>(std::floor(world.camera.GetInterpolatedX(alpha)));
+        m_renderQueue.SetOffset(cameraX, 0);
         
-        for (const auto& coin : m_coins) {
-            coin->Render(m_renderer);
-        }
+        // Entities outside the view are culled by the stores
+        Rectangle view = world.camera.GetInterpolatedView(alpha);
         
-        for (const auto& powerUp : m_powerUps) {
-            powerUp->Render(m_renderer);
-        }
+        // Static platforms come from cached textures, copied beneath everything recorded
+        m_staticLayer.Render(m_renderer, m_renderQueue, world.platforms, view, cameraX, world.levelLoadCount);
         
-        for (const auto& enemy : m_enemies) {
-            enemy->Render(m_renderer);
-        }
+        // Record game objects
+        world.movingPlatforms.Render(m_renderQueue, view, alpha);
+        world.coins.Render(m_renderQueue, m_sprites, view);
+        world.powerUps.Render(m_renderQueue, m_sprites, view);
+        world.enemies.Render(m_renderQueue, m_sprites, view, alpha);
         
-        if (m_player) {
-            m_player->Render(m_renderer);
+        if (world.player) {
+            world.player->Render(m_renderQueue, m_sprites, alpha);
         }
         
-        // Render particles
-        m_particleSystem->Render(m_renderer);
-        
         // Render finish flag when close to completion
-        int coinsCollected = 0;
-        for (const auto& coin : m_coins) {
-            if (coin->IsCollected()) {
-                coinsCollected++;
-            }
-        }
-        if (coinsCollected >= static_cast<int>(m_coins.size()) - 3) {
-            // Draw finish flag pole
-            SDL_SetRenderDrawColor(m_renderer, 139, 69, 19, 255); // Brown pole
-            SDL_Rect flagPole = {920, WINDOW_HEIGHT - 250, 8, 200};
-            SDL_RenderFillRect(m_renderer, &flagPole);
+        if (world.collectedCoins >= world.coinCount - 3) {
+            m_renderQueue.SetLayer(RenderLayer::GOAL);
+            m_renderQueue.BeginItem();
+            
+            // Draw finish flag pole near the end of the level
+            int poleX = static_cast<int>(world.width) - 80;
+            m_renderQueue.SetDrawColor(139, 69, 19, 255); // Brown pole
+            SDL_Rect flagPole = {poleX, WINDOW_HEIGHT - 250, 8, 200};
+            m_renderQueue.FillRect(flagPole);
             
             // Draw flag
-            SDL_SetRenderDrawColor(m_renderer, 255, 0, 0, 255); // Red flag
-            SDL_Rect flag = {928, WINDOW_HEIGHT - 240, 40, 30};
-            SDL_RenderFillRect(m_renderer, &flag);
+            m_renderQueue.SetDrawColor(255, 0, 0, 255); // Red flag
+            SDL_Rect flag = {poleX + 8, WINDOW_HEIGHT - 240, 40, 30};
+            m_renderQueue.FillRect(flag);
             
             // Draw flag details
-            SDL_SetRenderDrawColor(m_renderer, 255, 255, 255, 255); // White stripes
-            SDL_Rect stripe1 = {930, WINDOW_HEIGHT - 235, 36, 5};
-            SDL_Rect stripe2 = {930, WINDOW_HEIGHT - 225, 36, 5};
-            SDL_Rect stripe3 = {930, WINDOW_HEIGHT - 215, 36, 5};
-            SDL_RenderFillRect(m_renderer, &stripe1);
-            SDL_RenderFillRect(m_renderer, &stripe2);
-            SDL_RenderFillRect(m_renderer, &stripe3);
+            m_renderQueue.SetDrawColor(255, 255, 255, 255); // White stripes
+            SDL_Rect stripe1 = {poleX + 10, WINDOW_HEIGHT - 235, 36, 5};
+            SDL_Rect stripe2 = {poleX + 10, WINDOW_HEIGHT - 225, 36, 5};
+            SDL_Rect stripe3 = {poleX + 10, WINDOW_HEIGHT - 215, 36, 5};
+            m_renderQueue.FillRect(stripe1);
+            m_renderQueue.FillRect(stripe2);
+            m_renderQueue.FillRect(stripe3);
             
             // Draw "GOAL" text above flag
-            SDL_SetRenderDrawColor(m_renderer, 255, 255, 0, 255);
-            SDL_Rect goalBg = {905, WINDOW_HEIGHT - 280, 60, 20};
-            SDL_RenderFillRect(m_renderer, &goalBg);
+            m_renderQueue.SetDrawColor(255, 255, 0, 255);
+            SDL_Rect goalBg = {poleX - 15, WINDOW_HEIGHT - 280, 60, 20};
+            m_renderQueue.FillRect(goalBg);
             
-            SDL_SetRenderDrawColor(m_renderer, 255, 0, 0, 255);
-            SDL_Rect goalText = {910, WINDOW_HEIGHT - 275, 50, 10};
-            SDL_RenderFillRect(m_renderer, &goalText);
+            m_renderQueue.SetDrawColor(255, 0, 0, 255);
+            SDL_Rect goalText = {poleX - 10, WINDOW_HEIGHT - 275, 50, 10};
+            m_renderQueue.FillRect(goalText);
         }
         
-        // Render UI
-        RenderUI();
-        
-        if (m_gameState == GameState::PAUSED) {
-            // Render pause overlay
-            SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 128);
-            SDL_Rect overlay = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
-            SDL_RenderFillRect(m_renderer, &overlay);
-            
-            // Pause text
-            RenderTextCentered("PAUSED", WINDOW_HEIGHT/2 - 50, {255, 255, 255, 255});
-            RenderTextCentered("Press ESC to resume", WINDOW_HEIGHT/2 - 10, {255, 255, 255, 255});
-            RenderTextCentered("Press R to restart level", WINDOW_HEIGHT/2 + 30, {255, 255, 255, 255});
-        }
+        // Draw the world in batches before the particles and UI go on top
+        m_renderQueue.Submit(m_renderer);
     }
     
-    SDL_RenderPresent(m_renderer);
+    ProfileScope scope(&m_profiler, ProfileZone::RENDER_PARTICLES);
+    world.particles.Render(m_renderQueue, alpha);
+    m_renderQueue.Submit(m_renderer);
+    m_renderQueue.SetOffset(0, 0);
 }
 
-void Game::RenderText(const std::string& text, int x, int y, SDL_Color color) {
-    if (!m_font) {
-        // Fallback: render a colored rectangle as placeholder
-        SDL_SetRenderDrawColor(m_renderer, color.r, color.g, color.b, color.a);
-        SDL_Rect fallbackRect = {x, y, static_cast<int>(text.length() * 8), 20};
-        SDL_RenderFillRect(m_renderer, &fallbackRect);
+void Game::RenderProfilerOverlay(const WorldSnapshot& world) {
+    // Prefer the small font so every zone fits on screen
+    const GlyphAtlas& text = m_smallText.IsBuilt() ? m_smallText : m_text;
+    int lineHeight = text.IsBuilt() ? text.GetLineHeight() + 2 : 14;
+    int lines = Profiler::ZONE_COUNT + 2;
+    
+    char line[96];
+    std::snprintf(line, sizeof(line), "%-19s %6s %6s %6s %6s", "zone (ms)", "last", "min", "avg", "p99");
+    int width = text.IsBuilt() ? text.MeasureText(line) + 16 : 300;
+    
+    SDL_SetRenderDrawBlendMode(m_renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 180);
+    SDL_Rect panel = {WINDOW_WIDTH - width - 10, 130, width, lines * lineHeight + 10};
+    SDL_RenderFillRect(m_renderer, &panel);
+    SDL_SetRenderDrawBlendMode(m_renderer, SDL_BLENDMODE_NONE);
+    
+    if (!text.IsBuilt()) {
         return;
     }
     
-    // First render black shadow for better contrast
-    SDL_Surface* shadowSurface = TTF_RenderText_Solid(m_font, text.c_str(), {0, 0, 0, 255});
-    if (shadowSurface) {
-        SDL_Texture* shadowTexture = SDL_CreateTextureFromSurface(m_renderer, shadowSurface);
-        if (shadowTexture) {
-            SDL_Rect shadowRect = {x + 2, y + 2, shadowSurface->w, shadowSurface->h};
-            SDL_RenderCopy(m_renderer, shadowTexture, nullptr, &shadowRect);
-            SDL_DestroyTexture(shadowTexture);
-        }
-        SDL_FreeSurface(shadowSurface);
-    }
+    m_renderQueue.SetLayer(RenderLayer::TEXT);
+    m_renderQueue.BeginItem();
     
-    // Then render the main text
-    SDL_Surface* textSurface = TTF_RenderText_Solid(m_font, text.c_str(), color);
-    if (!textSurface) {
-        // Fallback to rectangle if text rendering fails
-        SDL_SetRenderDrawColor(m_renderer, color.r, color.g, color.b, color.a);
-        SDL_Rect fallbackRect = {x, y, static_cast<int>(text.length() * 8), 20};
-        SDL_RenderFillRect(m_renderer, &fallbackRect);
-        return;
+    int x = panel.x + 8;
+    int y = panel.y + 5;
+    text.DrawText(m_renderQueue, line, x, y, {255, 255, 0, 255});
+    y += lineHeight;
+    
+    // The simulation's profiler is written by its thread
+    std::lock_guard<std::mutex> lock(m_simulationMutex);
+    for (int zone = 0; zone < Profiler::ZONE_COUNT; zone++) {
+        ProfileZone profileZone = static_cast<ProfileZone>(zone);
+        const Profiler& profiler = IsSimulationZone(profileZone) ? m_simulationProfiler : m_profiler;
+        Profiler::ZoneStats stats = profiler.GetStats(profileZone);
+        std::snprintf(line, sizeof(line), "%-19s %6.2f %6.2f %6.2f %6.2f", Profiler::GetZoneName(profileZone),
+                      stats.last, stats.minimum, stats.average, stats.p99);
+        text.DrawText(m_renderQueue, line, x, y, {255, 255, 255, 255});
+        y += lineHeight;
     }
     
-    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(m_renderer, textSurface);
-    if (!textTexture) {
-        SDL_FreeSurface(textSurface);
-        // Fallback to rectangle
+    std::snprintf(line, sizeof(line), "%zu frames, %zu particles  F2: save CSV", m_profiler.GetHistorySize(),
+                  world.particles.GetCount());
+    text.DrawText(m_renderQueue, line, x, y, {180, 180, 180, 255});
+}
+
+void Game::RenderText(const std::string& text, int x, int y, SDL_Color color) {
+    if (!m_text.IsBuilt()) {
+        // Fallback: render a colored rectangle as placeholder
         SDL_SetRenderDrawColor(m_renderer, color.r, color.g, color.b, color.a);
         SDL_Rect fallbackRect = {x, y, static_cast<int>(text.length() * 8), 20};
         SDL_RenderFillRect(m_renderer, &fallbackRect);
         return;
     }
     
-    SDL_Rect destRect = {x, y, textSurface->w, textSurface->h};
-    SDL_RenderCopy(m_renderer, textTexture, nullptr, &destRect);
-    
-    SDL_FreeSurface(textSurface);
-    SDL_DestroyTexture(textTexture);
+    // Shadow and text come from the same glyphs; all shadows of a frame share
+    // one batch and all text another when the queue is submitted
+    m_renderQueue.SetLayer(RenderLayer::TEXT);
+    m_renderQueue.BeginItem();
+    m_text.DrawText(m_renderQueue, text, x + 2, y + 2, {0, 0, 0, 255});
+    m_text.DrawText(m_renderQueue, text, x, y, color);
 }
 
 void Game::RenderTextCentered(const std::string& text, int y, SDL_Color color) {
-    if (!m_font) {
+    if (!m_text.IsBuilt()) {
         // Fallback: estimate center position
         int estimatedWidth = text.length() * 8;
         int x = (WINDOW_WIDTH - estimatedWidth) / 2;
@@ -664,34 +715,27 @@ void Game::RenderTextCentered(const std::string& text, int y, SDL_Color color) {
         return;
     }
     
-    int textWidth, textHeight;
-    if (TTF_SizeText(m_font, text.c_str(), &textWidth, &textHeight) == 0) {
-        int x = (WINDOW_WIDTH - textWidth) / 2;
-        RenderText(text, x, y, color);
-    } else {
-        // Fallback if size calculation fails
-        int estimatedWidth = text.length() * 8;
-        int x = (WINDOW_WIDTH - estimatedWidth) / 2;
-        RenderText(text, x, y, color);
-    }
+    int x = (WINDOW_WIDTH - m_text.MeasureText(text)) / 2;
+    RenderText(text, x, y, color);
 }
 
-void Game::RenderUI() {
+void Game::RenderUI(const WorldSnapshot& world) {
     // Score
-    std::string scoreText = "Score: " + std::to_string(m_score);
+    std::string scoreText = "Score: " + std::to_string(world.score);
     RenderText(scoreText, 10, 10, {255, 255, 255, 255});
     
     // Level
-    std::string levelText = "Level: " + std::to_string(m_level);
+    std::string levelText = "Level: " + std::to_string(world.level);
     RenderText(levelText, 10, 40, {255, 255, 255, 255});
     
     // Lives
-    std::string livesText = "Lives: " + std::to_string(m_lives);
+    int lives = world.lives;
+    std::string livesText = "Lives: " + std::to_string(lives);
     RenderText(livesText, 10, 70, {255, 255, 255, 255});
     
     // Draw hearts for lives
     SDL_SetRenderDrawColor(m_renderer, 255, 0, 0, 255);
-    for (int i = 0; i < m_lives && i < 5; i++) {
+    for (int i = 0; i < lives && i < 5; i++) {
         int x = 120 + i * 25;
         int y = 73;
         // Simple heart shape approximation
@@ -700,13 +744,8 @@ void Game::RenderUI() {
     }
     
     // Coin progress indicator
-    int coinsCollected = 0;
-    int totalCoins = m_coins.size();
-    for (const auto& coin : m_coins) {
-        if (coin->IsCollected()) {
-            coinsCollected++;
-        }
-    }
+    int coinsCollected = world.collectedCoins;
+    int totalCoins = world.coinCount;
     
     // Coins text
     std::string coinsText = "Coins: " + std::to_string(coinsCollected) + "/" + std::to_string(totalCoins);
@@ -731,7 +770,7 @@ void Game::RenderUI() {
     }
     
     // Power-up indicator
-    if (m_player && m_player->IsPoweredUp()) {
+    if (world.player && world.player->IsPoweredUp()) {
         RenderText("POWERED UP!", WINDOW_WIDTH - 130, 15, {255, 255, 0, 255});
     }
 }
@@ -775,9 +814,9 @@ void Game::RenderMenu() {
     RenderTextCentered("Press SPACE or ENTER to select", 490, {255, 255, 255, 255});
     
     // Create some demo particles
-    m_particleSystem->CreateCoinEffect(Vector2(200, 400));
-    m_particleSystem->CreatePowerUpEffect(Vector2(800, 400));
-    m_particleSystem->Render(m_renderer);
+    m_menuParticles.CreateCoinEffect(Vector2(200, 400));
+    m_menuParticles.CreatePowerUpEffect(Vector2(800, 400));
+    m_menuParticles.Render(m_renderQueue);
 }
 
 void Game::RenderInstructions() {
@@ -900,20 +939,20 @@ void Game::RenderInstructions() {
     RenderTextCentered("Press ESC, BACKSPACE, or SPACE to go back", 600, {255, 255, 255, 255});
     
     // Add some particle effects
-    m_particleSystem->CreateCoinEffect(Vector2(rightColumnX + 10, 200));
-    m_particleSystem->Render(m_renderer);
+    m_menuParticles.CreateCoinEffect(Vector2(rightColumnX + 10, 200));
+    m_menuParticles.Render(m_renderQueue);
 }
 
-void Game::RenderGameOver() {
+void Game::RenderGameOver(const WorldSnapshot& world) {
     // Game Over title
     RenderTextCentered("GAME OVER", 200, {255, 0, 0, 255});
     
     // Final score
-    std::string scoreText = "Final Score: " + std::to_string(m_score);
+    std::string scoreText = "Final Score: " + std::to_string(world.score);
     RenderTextCentered(scoreText, 280, {255, 255, 255, 255});
     
     // Level reached
-    std::string levelText = "Level Reached: " + std::to_string(m_level);
+    std::string levelText = "Level Reached: " + std::to_string(world.level);
     RenderTextCentered(levelText, 320, {255, 255, 255, 255});
     
     // Instructions
@@ -921,6 +960,9 @@ void Game::RenderGameOver() {
 }
 
 void Game::Shutdown() {
+    SaveRecording();
+    SaveGame();
+    
     if (m_font) {
         TTF_CloseFont(m_font);
         m_font = nullptr;
@@ -933,6 +975,12 @@ void Game::Shutdown() {
     
     TTF_Quit();
     
+    m_sprites.Destroy();
+    m_background.Destroy();
+    m_staticLayer.Destroy();
+    m_text.Destroy();
+    m_smallText.Destroy();
+    
     if (m_renderer) {
         SDL_DestroyRenderer(m_renderer);
         m_renderer = nullptr;
@@ -6,15 +6,19 @@
 #include <memory>
 #include <string>
 #include <cmath>
-
-// Forward declarations
-class Player;
-class Platform;
-class Enemy;
-class Coin;
-class MovingPlatform;
-class PowerUp;
-class ParticleSystem;
+#include <atomic>
+#include <mutex>
+#include "Types.h"
+#include "World.h"
+#include "RenderQueue.h"
+#include "SpriteAtlas.h"
+#include "GlyphAtlas.h"
+#include "Background.h"
+#include "StaticLayer.h"
+#include "Profiler.h"
+#include "InputRecording.h"
+#include "WorldSnapshot.h"
+#include "TripleBuffer.h"
 
 enum class GameState {
     MENU,
@@ -38,14 +42,47 @@ public:
     void Run();
     void Shutdown();
     
+    // Fixed simulation rate in ticks per second (e.g. 60 or 120)
+    void SetTickRate(int ticksPerSecond);
+    
+    // Save each played session's input to this file (written at game over and on exit)
+    void SetRecordPath(const std::string& path);
+    // Play a recorded session instead of reading the keyboard; quits when it ends
+    void SetReplay(const InputRecording& recording);
+    // Play this layout (e.g. a generated stress scenario) instead of the built-in levels
+    void SetScenario(const LevelLayout& layout);
+    // Play a compiled level file instead; it must stay open until the game shuts down
+    void SetLevelFile(const LevelFile* file);
+    // Continue the game saved in this file, if there is one, on the first Play, and
+    // save it there when quitting mid-game (the file is removed once a game is over)
+    void SetSavePath(const std::string& path);
+    // Threads for the simulation's parallel loops; must outlive the game
+    void SetJobSystem(JobSystem* jobs);
+    // Tick on a thread of its own while Run() renders (the default where threads
+    // exist), or alternate ticks and frames on the calling thread
+    void SetSimulationThread(bool enabled);
+    
 private:
+    // What Render() draws, published by the simulation after its ticks
+    struct Frame {
+        WorldSnapshot world;
+        GameState state = GameState::MENU;
+        Uint64 counter = 0;        // Performance counter when it was published
+        double accumulator = 0.0;  // Time that was left in the accumulator then
+    };
+    
     void HandleEvents();
+    void RunSimulation();
+    void AdvanceSimulation();
+    void PublishFrame(Uint64 counter);
     void Update();
     void Render();
-    void RenderUI();
+    void RenderWorld(const WorldSnapshot& world, float alpha);
+    void RenderUI(const WorldSnapshot& world);
     void RenderMenu();
     void RenderInstructions();
-    void RenderGameOver();
+    void RenderGameOver(const WorldSnapshot& world);
+    void RenderProfilerOverlay(const WorldSnapshot& world);
     
     // Text rendering helpers
     void RenderText(const std::string& text, int x, int y, SDL_Color color = {255, 255, 255, 255});
@@ -53,70 +90,78 @@ private:
     
     // Game state management
     void ResetGame();
-    void NextLevel();
+    void RestartLevel();
+    PlayerInput ReadPlayerInput() const;
+    void SaveRecording();
+    void FinishReplay();
+    void ContinueSavedGame();
+    void SaveGame();
     
     SDL_Window* m_window;
     SDL_Renderer* m_renderer;
     TTF_Font* m_font;
     TTF_Font* m_smallFont;
-    bool m_isRunning;
+    GlyphAtlas m_text;       // Glyphs of m_font
+    GlyphAtlas m_smallText;  // Glyphs of m_smallFont
+    std::atomic<bool> m_isRunning;
+    
+    // World drawing is recorded here and submitted in batches
+    RenderQueue m_renderQueue;
+    SpriteAtlas m_sprites;
+    Background m_background;
+    StaticLayer m_staticLayer;  // Platforms, drawn once per level
+    
+    // Frame timings; F1 toggles the overlay, F2 writes the history to CSV.
+    // The simulation's ticks are timed separately since they may run on
+    // another thread; each wake of the simulation is one of its frames.
+    Profiler m_profiler;
+    Profiler m_simulationProfiler;
+    bool m_showProfiler;
+    
+    // Simulation (entities, collisions, scoring)
+    std::unique_ptr<World> m_world;
+    
+    // Everything the simulation touches (the world, game state, input,
+    // recording, m_simulationProfiler) is only accessed under this mutex;
+    // the renderer draws from published frames and never touches the world
+    std::mutex m_simulationMutex;
+    TripleBuffer<Frame> m_frames;
+    bool m_useSimulationThread;
     
-    // Game objects
-    std::unique_ptr<Player> m_player;
-    std::vector<std::unique_ptr<Platform>> m_platforms;
-    std::vector<std::unique_ptr<MovingPlatform>> m_movingPlatforms;
-    std::vector<std::unique_ptr<Enemy>> m_enemies;
-    std::vector<std::unique_ptr<Coin>> m_coins;
-    std::vector<std::unique_ptr<PowerUp>> m_powerUps;
-    std::unique_ptr<ParticleSystem> m_particleSystem;
+    // The menu screens' demo effects, owned by the render side
+    ParticleSystem m_menuParticles;
     
     // Game state
     GameState m_gameState;
     MenuOption m_selectedMenuOption;
-    int m_score;
-    int m_lives;
-    int m_level;
-    float m_levelTime;
     
     // Game constants
-    static const int WINDOW_WIDTH = 1000;
-    static const int WINDOW_HEIGHT = 700;
-    static const float GRAVITY;
+    static const int WINDOW_WIDTH = World::WIDTH;
+    static const int WINDOW_HEIGHT = World::HEIGHT;
     
-    Uint32 m_lastFrameTime;
-    float m_deltaTime;
+    // Fixed-timestep simulation
+    Uint64 m_lastFrameCounter;
+    double m_accumulator;
+    float m_deltaTime;          // Fixed tick length used by Update()
+    static const float MAX_FRAME_TIME;
+    
+    // Input recording and replay
+    InputRecording m_recording;
+    std::string m_recordPath;
+    bool m_isRecording;
+    bool m_isReplaying;
+    bool m_restartPending;      // Next recorded tick starts with a restart
+    size_t m_replayTick;
+    
+    std::unique_ptr<LevelLayout> m_scenario;
+    const LevelFile* m_levelFile;
+    
+    // The world as the session started, restored by restarts instead of reloading the level
+    std::vector<std::uint8_t> m_startState;
+    std::string m_savePath;
+    bool m_continuePending;     // The saved game has not been picked up yet
     
     // Input handling
     bool m_keys[SDL_NUM_SCANCODES];
     bool m_keysPressed[SDL_NUM_SCANCODES];
 };
-
-// Enhanced utility structs
-struct Vector2 {
-    float x, y;
-    Vector2(float x = 0, float y = 0) : x(x), y(y) {}
-    Vector2 operator+(const Vector2& other) const { return Vector2(x + other.x, y + other.y); }
-    Vector2 operator-(const Vector2& other) const { return Vector2(x - other.x, y - other.y); }
-    Vector2 operator*(float scalar) const { return Vector2(x * scalar, y * scalar); }
-    float Length() const { return sqrt(x*x + y*y); }
-    Vector2 Normalized() const { float len = Length(); return len > 0 ? Vector2(x/len, y/len) : Vector2(0,0); }
-};
-
-struct Rectangle {
-    float x, y, width, height;
-    Rectangle(float x = 0, float y = 0, float w = 0, float h = 0) : x(x), y(y), width(w), height(h) {}
-    
-    bool Intersects(const Rectangle& other) const {
-        return x < other.x + other.width &&
-               x + width > other.x &&
-               y < other.y + other.height &&
-               y + height > other.y;
-    }
-    
-    Vector2 Center() const { return Vector2(x + width/2, y + height/2); }
-};
-
-struct Color {
-    Uint8 r, g, b, a;
-    Color(Uint8 r = 255, Uint8 g = 255, Uint8 b = 255, Uint8 a = 255) : r(r), g(g), b(b), a(a) {}
-}; 
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "GlyphAtlas.h"
+#include "RenderQueue.h"
+#include <algorithm>
+
+const int GlyphAtlas::ATLAS_WIDTH = 512;
+
+GlyphAtlas::GlyphAtlas() : m_texture(nullptr), m_lineHeight(0) {
+    for (Glyph& glyph : m_glyphs) {
+        glyph.source = {0, 0, 0, 0};
+        glyph.advance = 0;
+    }
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    Destroy();
+}
+
+bool GlyphAtlas::Build(SDL_Renderer* renderer, TTF_Font* font) {
+    Destroy();
+    if (!font) {
+        return false;
+    }
+    
+    // Render every glyph in white; colour is applied per vertex when drawing.
+    // Single-character strings keep the same bearing as whole-string rendering.
+    SDL_Surface* surfaces[GLYPH_COUNT] = {};
+    int cursorX = 0;
+    int cursorY = 0;
+    int rowHeight = 0;
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        char text[2] = {static_cast<char>(FIRST_CHARACTER + i), '\0'};
+        surfaces[i] = TTF_RenderText_Solid(font, text, {255, 255, 255, 255});
+        
+        int advance = 0;
+        if (TTF_GlyphMetrics(font, static_cast<Uint16>(text[0]), nullptr, nullptr, nullptr, nullptr, &advance) != 0) {
+            advance = surfaces[i] ? surfaces[i]->w : 0;
+        }
+        m_glyphs[i].advance = advance;
+        
+        if (!surfaces[i]) continue;
+        
+        if (cursorX + surfaces[i]->w > ATLAS_WIDTH) {
+            cursorX = 0;
+            cursorY += rowHeight + 1;
+            rowHeight = 0;
+        }
+        m_glyphs[i].source = {cursorX, cursorY, surfaces[i]->w, surfaces[i]->h};
+        cursorX += surfaces[i]->w + 1;
+        rowHeight = std::max(rowHeight, surfaces[i]->h);
+    }
+    m_lineHeight = TTF_FontHeight(font);
+    
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, std::max(1, cursorY + rowHeight), 32, SDL_PIXELFORMAT_RGBA32);
+    if (atlas) {
+        // New surfaces are zero-filled, i.e. fully transparent
+        for (int i = 0; i < GLYPH_COUNT; i++) {
+            if (surfaces[i]) {
+                SDL_Rect destination = m_glyphs[i].source;
+                SDL_BlitSurface(surfaces[i], nullptr, atlas, &destination);
+            }
+        }
+        m_texture = SDL_CreateTextureFromSurface(renderer, atlas);
+        SDL_FreeSurface(atlas);
+    }
+    
+    for (SDL_Surface* surface : surfaces) {
+        if (surface) {
+            SDL_FreeSurface(surface);
+        }
+    }
+    
+    if (!m_texture) {
+        return false;
+    }
+    SDL_SetTextureBlendMode(m_texture, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+void GlyphAtlas::Destroy() {
+    if (m_texture) {
+        SDL_DestroyTexture(m_texture);
+        m_texture = nullptr;
+    }
+}
+
+int GlyphAtlas::MeasureText(const std::string& text) const {
+    int width = 0;
+    for (char character : text) {
+        width += GetGlyph(character).advance;
+    }
+    return width;
+}
+
+void GlyphAtlas::DrawText(RenderQueue& queue, const std::string& text, int x, int y, SDL_Color color) const {
+    if (!m_texture) return;
+    
+    queue.SetDrawColor(color.r, color.g, color.b, color.a);
+    int penX = x;
+    for (char character : text) {
+        const Glyph& glyph = GetGlyph(character);
+        if (glyph.source.w > 0 && character != ' ') {
+            SDL_Rect destination = {penX, y, glyph.source.w, glyph.source.h};
+            queue.DrawTexture(m_texture, glyph.source, destination);
+        }
+        penX += glyph.advance;
+    }
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::GetGlyph(char character) const {
+    int index = static_cast<unsigned char>(character) - FIRST_CHARACTER;
+    if (index < 0 || index >= GLYPH_COUNT) {
+        index = '?' - FIRST_CHARACTER; // Outside printable ASCII
+    }
+    return m_glyphs[index];
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <string>
+
+class RenderQueue;
+
+// Printable ASCII glyphs of one font rendered once into a single texture.
+// Text is then recorded as one textured quad per character, tinted through
+// the vertex colour, so any colour (and the drop shadow) comes from the same
+// glyphs without creating textures per string.
+class GlyphAtlas {
+public:
+    GlyphAtlas();
+    ~GlyphAtlas();
+    
+    bool Build(SDL_Renderer* renderer, TTF_Font* font);
+    void Destroy();
+    bool IsBuilt() const { return m_texture != nullptr; }
+    
+    // Width of the text in pixels, summed from the cached glyph advances
+    int MeasureText(const std::string& text) const;
+    int GetLineHeight() const { return m_lineHeight; }
+    
+    // Record the text with its top-left corner at (x, y)
+    void DrawText(RenderQueue& queue, const std::string& text, int x, int y, SDL_Color color) const;
+    
+private:
+    struct Glyph {
+        SDL_Rect source;
+        int advance;
+    };
+    
+    const Glyph& GetGlyph(char character) const;
+    
+    static const int FIRST_CHARACTER = 32;  // Space
+    static const int LAST_CHARACTER = 126;  // Tilde
+    static const int GLYPH_COUNT = LAST_CHARACTER - FIRST_CHARACTER + 1;
+    static const int ATLAS_WIDTH;
+    
+    Glyph m_glyphs[GLYPH_COUNT];
+    SDL_Texture* m_texture;
+    int m_lineHeight;
+};
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "InputRecording.h"
+#include "World.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+// File layout (little endian): magic, version, tick rate, seed, start level, tick count, tick bytes
+static const char RECORDING_MAGIC[4] = {'M', 'R', 'I', 'N'};
+static const std::uint32_t RECORDING_VERSION = 1;
+
+static void WriteU32(std::ofstream& file, std::uint32_t value) {
+    unsigned char bytes[4] = {
+        static_cast<unsigned char>(value & 0xFF),
+        static_cast<unsigned char>((value >> 8) & 0xFF),
+        static_cast<unsigned char>((value >> 16) & 0xFF),
+        static_cast<unsigned char>((value >> 24) & 0xFF)
+    };
+    file.write(reinterpret_cast<const char*>(bytes), 4);
+}
+
+static bool ReadU32(std::ifstream& file, std::uint32_t& value) {
+    unsigned char bytes[4];
+    if (!file.read(reinterpret_cast<char*>(bytes), 4)) {
+        return false;
+    }
+    value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+    return true;
+}
+
+InputRecording::InputRecording() : m_tickRate(60), m_seed(0), m_startLevel(1) {
+}
+
+void InputRecording::Begin(int tickRate, std::uint32_t seed, int startLevel) {
+    m_tickRate = tickRate;
+    m_seed = seed;
+    m_startLevel = startLevel;
+    m_ticks.clear();
+}
+
+void InputRecording::AddTick(const PlayerInput& input, bool restart) {
+    std::uint8_t bits = Pack(input);
+    if (restart) {
+        bits |= RESTART;
+    }
+    m_ticks.push_back(bits);
+}
+
+bool InputRecording::Save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    
+    file.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+    WriteU32(file, RECORDING_VERSION);
+    WriteU32(file, static_cast<std::uint32_t>(m_tickRate));
+    WriteU32(file, m_seed);
+    WriteU32(file, static_cast<std::uint32_t>(m_startLevel));
+    WriteU32(file, static_cast<std::uint32_t>(m_ticks.size()));
+    file.write(reinterpret_cast<const char*>(m_ticks.data()), m_ticks.size());
+    return static_cast<bool>(file);
+}
+
+bool InputRecording::Load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    
+    char magic[4];
+    std::uint32_t version, tickRate, seed, startLevel, tickCount;
+    if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, RECORDING_MAGIC)) {
+        return false;
+    }
+    if (!ReadU32(file, version) || version != RECORDING_VERSION ||
+        !ReadU32(file, tickRate) || !ReadU32(file, seed) ||
+        !ReadU32(file, startLevel) || !ReadU32(file, tickCount)) {
+        return false;
+    }
+    // Both are used as ints; a start level is reached by building every level before it
+    if (tickRate == 0 || tickRate > static_cast<std::uint32_t>(std::numeric_limits<int>::max()) ||
+        startLevel == 0 || startLevel > static_cast<std::uint32_t>(World::MAX_LEVEL)) {
+        return false;
+    }
+    
+    std::vector<std::uint8_t> ticks(tickCount);
+    if (!file.read(reinterpret_cast<char*>(ticks.data()), tickCount)) {
+        return false;
+    }
+    
+    m_tickRate = static_cast<int>(tickRate);
+    m_seed = seed;
+    m_startLevel = static_cast<int>(startLevel);
+    m_ticks.swap(ticks);
+    return true;
+}
+
+PlayerInput InputRecording::GetInput(size_t tick) const {
+    return Unpack(m_ticks[tick]);
+}
+
+std::uint8_t InputRecording::Pack(const PlayerInput& input) {
+    std::uint8_t bits = 0;
+    if (input.left) bits |= LEFT;
+    if (input.right) bits |= RIGHT;
+    if (input.jump) bits |= JUMP;
+    if (input.jumpPressed) bits |= JUMP_PRESSED;
+    return bits;
+}
+
+PlayerInput InputRecording::Unpack(std::uint8_t bits) {
+    PlayerInput input;
+    input.left = (bits & LEFT) != 0;
+    input.right = (bits & RIGHT) != 0;
+    input.jump = (bits & JUMP) != 0;
+    input.jumpPressed = (bits & JUMP_PRESSED) != 0;
+    return input;
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+#include "Player.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Per-tick player input captured from a session, plus everything else the
+// simulation needs to reproduce it exactly: tick rate, RNG seed and starting
+// level. Stored as a small header followed by one byte of action bits per tick.
+// Replaying the same file always produces the same World state.
+class InputRecording {
+public:
+    // Action bits stored for each tick
+    enum : std::uint8_t {
+        LEFT = 1 << 0,
+        RIGHT = 1 << 1,
+        JUMP = 1 << 2,
+        JUMP_PRESSED = 1 << 3,
+        RESTART = 1 << 4   // World was reset to the starting level before this tick
+    };
+    
+    InputRecording();
+    
+    // Start an empty recording with the given session parameters
+    void Begin(int tickRate, std::uint32_t seed, int startLevel);
+    void Clear() { m_ticks.clear(); }
+    void AddTick(const PlayerInput& input, bool restart = false);
+    
+    bool Save(const std::string& path) const;
+    bool Load(const std::string& path);
+    
+    size_t GetTickCount() const { return m_ticks.size(); }
+    PlayerInput GetInput(size_t tick) const;
+    bool IsRestart(size_t tick) const { return (m_ticks[tick] & RESTART) != 0; }
+    
+    int GetTickRate() const { return m_tickRate; }
+    std::uint32_t GetSeed() const { return m_seed; }
+    int GetStartLevel() const { return m_startLevel; }
+    
+    static std::uint8_t Pack(const PlayerInput& input);
+    static PlayerInput Unpack(std::uint8_t bits);
+    
+private:
+    int m_tickRate;
+    std::uint32_t m_seed;
+    int m_startLevel;
+    std::vector<std::uint8_t> m_ticks;
+};
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "JobSystem.h"
+
+JobSystem::JobSystem(int workerCount)
+    : m_function(nullptr), m_remaining(0), m_generation(0), m_isStopping(false) {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    workerCount = 0;
+#endif
+    workerCount = std::max(workerCount, 0);
+    
+    for (int i = 0; i <= workerCount; i++) {
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (int i = 0; i < workerCount; i++) {
+        m_workers.emplace_back(&JobSystem::WorkerLoop, this, static_cast<size_t>(i + 1));
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_isStopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+int JobSystem::DefaultWorkerCount() {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    return 0;
+#else
+    unsigned hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? static_cast<int>(hardwareThreads) - 1 : 0;
+#endif
+}
+
+void JobSystem::ParallelFor(size_t count, size_t batchSize, const BatchFunction& function) {
+    if (count == 0) return;
+    batchSize = std::max<size_t>(batchSize, 1);
+    
+    // A single batch isn't worth waking anyone for
+    size_t batchCount = CountBatches(count, batchSize);
+    if (m_workers.empty() || batchCount == 1) {
+        ::ParallelFor(nullptr, count, batchSize, function);
+        return;
+    }
+    
+    m_function = &function;
+    m_remaining.store(batchCount, std::memory_order_relaxed);
+    for (size_t batch = 0; batch < batchCount; batch++) {
+        size_t begin = batch * batchSize;
+        WorkQueue& queue = *m_queues[batch % m_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.batches.push_back(Batch{batch, begin, std::min(begin + batchSize, count)});
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_generation++;
+    }
+    m_wake.notify_all();
+    
+    RunBatches(0);
+    
+    // Batches stolen by workers may still be running
+    while (m_remaining.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+    m_function = nullptr;
+}
+
+void JobSystem::WorkerLoop(size_t queue) {
+    unsigned seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_wake.wait(lock, [this, seenGeneration]() { return m_isStopping || m_generation != seenGeneration; });
+            if (m_isStopping) return;
+            seenGeneration = m_generation;
+        }
+        RunBatches(queue);
+    }
+}
+
+void JobSystem::RunBatches(size_t queue) {
+    Batch batch;
+    while (Pop(queue, batch) || Steal(queue, batch)) {
+        (*m_function)(batch.index, batch.begin, batch.end);
+        m_remaining.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+bool JobSystem::Pop(size_t queue, Batch& batch) {
+    WorkQueue& own = *m_queues[queue];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (own.batches.empty()) return false;
+    
+    batch = own.batches.front();
+    own.batches.pop_front();
+    return true;
+}
+
+bool JobSystem::Steal(size_t thief, Batch& batch) {
+    // Start with the next queue so thieves spread over their victims
+    for (size_t offset = 1; offset < m_queues.size(); offset++) {
+        WorkQueue& victim = *m_queues[(thief + offset) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.batches.empty()) continue;
+        
+        batch = victim.batches.back();
+        victim.batches.pop_back();
+        return true;
+    }
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool for data-parallel loops over entity arrays.
+//
+// ParallelFor() cuts [0, count) into batches of batchSize elements, deals
+// them round-robin into one queue per thread and works along on the calling
+// thread. A thread pops batches from the front of its own queue and, once
+// that is empty, steals from the back of the others.
+//
+// Batch boundaries depend only on count and batchSize, never on the number
+// of threads or on who ran what. Loops that produce side effects (spawning
+// particles, adding score) write them to a per-batch buffer indexed by the
+// batch number and merge the buffers in batch order afterwards, so the
+// result is the same with one thread or sixteen.
+class JobSystem {
+public:
+    // Run batch [begin, end); batch is its index in [0, CountBatches())
+    typedef std::function<void(size_t batch, size_t begin, size_t end)> BatchFunction;
+    
+    // workerCount threads in addition to the caller; 0 runs everything on the caller
+    explicit JobSystem(int workerCount = DefaultWorkerCount());
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    
+    // Blocks until every batch has run. Must only be called from one thread
+    // at a time, and not from inside a batch.
+    void ParallelFor(size_t count, size_t batchSize, const BatchFunction& function);
+    
+    int GetWorkerCount() const { return static_cast<int>(m_workers.size()); }
+    
+    // One worker per hardware thread besides the caller (none where threads are unavailable)
+    static int DefaultWorkerCount();
+    static size_t CountBatches(size_t count, size_t batchSize) { return (count + batchSize - 1) / batchSize; }
+    
+private:
+    struct Batch {
+        size_t index;
+        size_t begin;
+        size_t end;
+    };
+    
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Batch> batches;
+    };
+    
+    void WorkerLoop(size_t queue);
+    // Run batches from the given queue, then steal, until no work is left anywhere
+    void RunBatches(size_t queue);
+    bool Pop(size_t queue, Batch& batch);
+    bool Steal(size_t thief, Batch& batch);
+    
+    std::vector<std::thread> m_workers;
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;  // [0] is the caller's, [i + 1] worker i's
+    
+    const BatchFunction* m_function;
+    std::atomic<size_t> m_remaining;  // Batches of the current loop not finished yet
+    
+    // Workers sleep here between loops
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    unsigned m_generation;  // Bumped for every loop
+    bool m_isStopping;
+};
+
+// Runs inline, batch by batch, when jobs is null so callers need no serial path
+inline void ParallelFor(JobSystem* jobs, size_t count, size_t batchSize, const JobSystem::BatchFunction& function) {
+    if (jobs) {
+        jobs->ParallelFor(count, batchSize, function);
+        return;
+    }
+    for (size_t batch = 0, begin = 0; begin < count; batch++, begin += batchSize) {
+        function(batch, begin, std::min(begin + batchSize, count));
+    }
+}
\ No newline at end of file
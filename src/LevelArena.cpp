@@ -0,0 +1,60 @@
+#include "LevelArena.h"
+#include <algorithm>
+
+LevelArena::LevelArena(size_t blockSize) 
+    : m_used(0), m_blockSize(blockSize), m_allocationCount(0), m_heapAllocationCount(0) {
+}
+
+void* LevelArena::Allocate(size_t bytes, size_t alignment) {
+    m_allocationCount++;
+    
+    if (!m_blocks.empty()) {
+        Block& block = m_blocks.back();
+        std::uintptr_t start = reinterpret_cast<std::uintptr_t>(block.data.get()) + m_used;
+        size_t padding = (alignment - start % alignment) % alignment;
+        if (m_used + padding + bytes <= block.size) {
+            m_used += padding + bytes;
+            return block.data.get() + m_used - bytes;
+        }
+    }
+    
+    // Blocks come from new[], which aligns for any fundamental type
+    AddBlock(bytes);
+    m_used = bytes;
+    return m_blocks.back().data.get();
+}
+
+void LevelArena::Reset() {
+    // Merge the blocks this level needed so the next one fits in one
+    if (m_blocks.size() > 1) {
+        size_t capacity = GetCapacity();
+        m_blocks.clear();
+        AddBlock(capacity);
+    }
+    m_used = 0;
+    m_allocationCount = 0;
+}
+
+size_t LevelArena::GetBytesUsed() const {
+    size_t used = m_used;
+    for (size_t i = 0; i + 1 < m_blocks.size(); i++) {
+        used += m_blocks[i].size;
+    }
+    return used;
+}
+
+size_t LevelArena::GetCapacity() const {
+    size_t capacity = 0;
+    for (const Block& block : m_blocks) {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+void LevelArena::AddBlock(size_t minimumSize) {
+    Block block;
+    block.size = std::max(minimumSize, m_blockSize);
+    block.data.reset(new std::uint8_t[block.size]);
+    m_blocks.push_back(std::move(block));
+    m_heapAllocationCount++;
+}
\ No newline at end of file
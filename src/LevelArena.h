@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Bump allocator for everything that lives exactly as long as one level: the
+// entity store columns and the emitter list. Allocate() hands out the next
+// bytes of the current block and nothing is freed individually; Reset()
+// rewinds to the start for the next level in O(1). When a level needs more
+// than the block holds, the arena chains further blocks from the heap and
+// merges them into one block of the combined size at the next Reset(), so
+// from then on loading levels of that size never touches the heap.
+class LevelArena {
+public:
+    explicit LevelArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    LevelArena(const LevelArena&) = delete;
+    LevelArena& operator=(const LevelArena&) = delete;
+    
+    void* Allocate(size_t bytes, size_t alignment);
+    
+    // Everything allocated so far becomes invalid
+    void Reset();
+    
+    // Allocations served since the last Reset()
+    size_t GetAllocationCount() const { return m_allocationCount; }
+    size_t GetBytesUsed() const;
+    size_t GetCapacity() const;
+    // Blocks requested from the general-purpose heap over the arena's lifetime
+    size_t GetHeapAllocationCount() const { return m_heapAllocationCount; }
+    
+    static const size_t DEFAULT_BLOCK_SIZE = 256 * 1024;
+    
+private:
+    struct Block {
+        std::unique_ptr<std::uint8_t[]> data;
+        size_t size;
+    };
+    
+    void AddBlock(size_t minimumSize);
+    
+    std::vector<Block> m_blocks;  // The last one is being allocated from
+    size_t m_used;                // Bytes used in the last block
+    size_t m_blockSize;
+    size_t m_allocationCount;
+    size_t m_heapAllocationCount;
+};
+
+// Standard allocator that takes its memory from a LevelArena, so containers
+// can hold level data without individual heap allocations. Deallocation is a
+// no-op; the memory comes back when the arena is reset. Without an arena it
+// falls back to the heap, which is also what copies of a container get (e.g.
+// render snapshots, which must outlive the level they were taken from).
+template <typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+    
+    ArenaAllocator(LevelArena* arena = nullptr) noexcept : m_arena(arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.GetArena()) {}
+    
+    T* allocate(size_t count) {
+        if (!m_arena) {
+            return std::allocator<T>().allocate(count);
+        }
+        return static_cast<T*>(m_arena->Allocate(count * sizeof(T), alignof(T)));
+    }
+    
+    void deallocate(T* pointer, size_t count) noexcept {
+        if (!m_arena) {
+            std::allocator<T>().deallocate(pointer, count);
+        }
+    }
+    
+    ArenaAllocator select_on_container_copy_construction() const { return ArenaAllocator(); }
+    
+    LevelArena* GetArena() const { return m_arena; }
+    
+private:
+    LevelArena* m_arena;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.GetArena() == b.GetArena(); }
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.GetArena() != b.GetArena(); }
+
+// Entity store column whose storage belongs to the current level
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
\ No newline at end of file
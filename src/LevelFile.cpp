@@ -0,0 +1,376 @@
+#include "LevelFile.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#if defined(_WIN32)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char LEVEL_MAGIC[4] = {'M', 'L', 'V', 'L'};
+static const std::uint32_t LEVEL_BYTE_ORDER = 0x01020304;  // Reads back differently on a foreign-endian machine
+
+const float LevelFile::CHUNK_WIDTH = 1024.0f;
+
+struct LevelFileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    float width;
+    float height;
+    float spawnX;
+    float spawnY;
+    float chunkWidth;
+    std::uint32_t chunkCount;
+    std::uint32_t platformCount;
+    std::uint32_t movingPlatformCount;
+    std::uint32_t enemyCount;
+    std::uint32_t coinCount;
+    std::uint32_t powerUpCount;
+    std::uint32_t emitterCount;
+};
+
+// Columns are used in place, so every element must be 4 bytes (records a multiple of 4)
+static_assert(sizeof(LevelFileHeader) % 4 == 0, "level columns must start 4-byte aligned");
+static_assert(sizeof(MovementType) == 4 && sizeof(PowerUpType) == 4, "enum columns are stored as 32-bit values");
+static_assert(sizeof(LevelLayout::EmitterRecord) == 16, "emitter records are stored as-is");
+
+static const std::uint64_t PLATFORM_BYTES = 4 * sizeof(float);
+static const std::uint64_t MOVING_PLATFORM_BYTES = 6 * sizeof(float) + sizeof(MovementType);
+static const std::uint64_t ENEMY_BYTES = 2 * sizeof(float);
+static const std::uint64_t COIN_BYTES = 2 * sizeof(float);
+static const std::uint64_t POWER_UP_BYTES = 2 * sizeof(float) + sizeof(PowerUpType);
+static const std::uint64_t EMITTER_BYTES = sizeof(LevelLayout::EmitterRecord);
+
+static size_t ChunkIndex(float x, size_t chunkCount) {
+    float chunk = std::floor(x / LevelFile::CHUNK_WIDTH);
+    if (!(chunk > 0.0f)) return 0;
+    return std::min(static_cast<size_t>(chunk), chunkCount - 1);
+}
+
+// Counting sort of records by the chunk their left edge is in. Keeps the
+// original order within a chunk, so a level that fits in one chunk loads in
+// exactly the order it was described.
+template <typename Record>
+static void SortIntoChunks(const std::vector<Record>& records, size_t chunkCount, 
+                           std::vector<std::uint32_t>& order, std::vector<std::uint32_t>& chunkStart, 
+                           std::vector<std::uint32_t>& next) {
+    chunkStart.assign(chunkCount + 1, 0);
+    for (const Record& record : records) {
+        chunkStart[ChunkIndex(record.x, chunkCount) + 1]++;
+    }
+    for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+        chunkStart[chunk + 1] += chunkStart[chunk];
+    }
+    
+    next.assign(chunkStart.begin(), chunkStart.end() - 1);
+    order.resize(records.size());
+    for (size_t i = 0; i < records.size(); i++) {
+        order[next[ChunkIndex(records[i].x, chunkCount)]++] = static_cast<std::uint32_t>(i);
+    }
+}
+
+static void Append(std::vector<std::uint8_t>& image, const void* data, size_t size) {
+    const std::uint8_t* bytes = static_cast<const std::uint8_t*>(data);
+    image.insert(image.end(), bytes, bytes + size);
+}
+
+// One field of every record, in chunk order
+template <typename Record, typename Field>
+static void AppendColumn(std::vector<std::uint8_t>& image, const std::vector<Record>& records, 
+                         const std::vector<std::uint32_t>& order, Field Record::* field) {
+    size_t offset = image.size();
+    image.resize(offset + order.size() * sizeof(Field));
+    std::uint8_t* out = image.data() + offset;
+    for (std::uint32_t index : order) {
+        std::memcpy(out, &(records[index].*field), sizeof(Field));
+        out += sizeof(Field);
+    }
+}
+
+LevelFile::LevelFile() : m_data(nullptr), m_size(0), m_isMapped(false), m_view() {
+}
+
+LevelFile::~LevelFile() {
+    Close();
+}
+
+bool LevelFile::Open(const std::string& path) {
+    Close();
+    if (!Map(path)) {
+        return false;
+    }
+    if (!BuildView()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void LevelFile::Build(const LevelLayout& layout) {
+    Close();
+    Compile(layout, m_tables, m_buffer);
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+    BuildView();
+}
+
+void LevelFile::Close() {
+#if !defined(_WIN32)
+    if (m_isMapped) {
+        munmap(const_cast<std::uint8_t*>(m_data), m_size);
+    }
+#endif
+    m_buffer.clear();  // Keeps its capacity for the next Build()
+    m_data = nullptr;
+    m_size = 0;
+    m_isMapped = false;
+    m_view = LevelView();
+}
+
+#if defined(_WIN32)
+bool LevelFile::Map(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    m_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (m_buffer.empty()) {
+        return false;
+    }
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+    return true;
+}
+#else
+bool LevelFile::Map(const std::string& path) {
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return false;
+    }
+    
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || status.st_size <= 0) {
+        close(descriptor);
+        return false;
+    }
+    
+    // Pages are faulted in as chunks stream in, so long levels only cost what is near the camera
+    void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    
+    m_data = static_cast<const std::uint8_t*>(data);
+    m_size = static_cast<size_t>(status.st_size);
+    m_isMapped = true;
+    return true;
+}
+#endif
+
+bool LevelFile::BuildView() {
+    LevelFileHeader header;
+    if (m_size < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, m_data, sizeof(header));
+    
+    if (std::memcmp(header.magic, LEVEL_MAGIC, sizeof(LEVEL_MAGIC)) != 0 ||
+        header.version != VERSION || header.byteOrder != LEVEL_BYTE_ORDER) {
+        return false;
+    }
+    if (!(header.width > 0.0f) || !(header.height > 0.0f) || !(header.chunkWidth > 0.0f) || header.chunkCount == 0) {
+        return false;
+    }
+    
+    std::uint64_t expectedSize = sizeof(header) +
+        header.platformCount * PLATFORM_BYTES + header.movingPlatformCount * MOVING_PLATFORM_BYTES +
+        header.enemyCount * ENEMY_BYTES + header.coinCount * COIN_BYTES +
+        header.powerUpCount * POWER_UP_BYTES + header.emitterCount * EMITTER_BYTES +
+        ENTITY_TYPE_COUNT * (header.chunkCount + std::uint64_t(1)) * sizeof(std::uint32_t);
+    if (expectedSize != m_size) {
+        return false;
+    }
+    
+    // Hand out consecutive columns of count elements each
+    const std::uint8_t* cursor = m_data + sizeof(header);
+    auto column = [&cursor](size_t count, size_t elementSize) {
+        const std::uint8_t* start = cursor;
+        cursor += count * elementSize;
+        return start;
+    };
+    
+    LevelView view;
+    view.width = header.width;
+    view.height = header.height;
+    view.playerSpawn = Vector2(header.spawnX, header.spawnY);
+    view.chunkWidth = header.chunkWidth;
+    view.chunkCount = header.chunkCount;
+    
+    view.platforms.count = header.platformCount;
+    view.platforms.x = reinterpret_cast<const float*>(column(header.platformCount, sizeof(float)));
+    view.platforms.y = reinterpret_cast<const float*>(column(header.platformCount, sizeof(float)));
+    view.platforms.width = reinterpret_cast<const float*>(column(header.platformCount, sizeof(float)));
+    view.platforms.height = reinterpret_cast<const float*>(column(header.platformCount, sizeof(float)));
+    
+    view.movingPlatforms.count = header.movingPlatformCount;
+    view.movingPlatforms.x = reinterpret_cast<const float*>(column(header.movingPlatformCount, sizeof(float)));
+    view.movingPlatforms.y = reinterpret_cast<const float*>(column(header.movingPlatformCount, sizeof(float)));
+    view.movingPlatforms.width = reinterpret_cast<const float*>(column(header.movingPlatformCount, sizeof(float)));
+    view.movingPlatforms.height = reinterpret_cast<const float*>(column(header.movingPlatformCount, sizeof(float)));
+    view.movingPlatforms.type = reinterpret_cast<const MovementType*>(column(header.movingPlatformCount, sizeof(MovementType)));
+    view.movingPlatforms.speed = reinterpret_cast<const float*>(column(header.movingPlatformCount, sizeof(float)));
+    view.movingPlatforms.range = reinterpret_cast<const float*>(column(header.movingPlatformCount, sizeof(float)));
+    
+    view.enemies.count = header.enemyCount;
+    view.enemies.x = reinterpret_cast<const float*>(column(header.enemyCount, sizeof(float)));
+    view.enemies.y = reinterpret_cast<const float*>(column(header.enemyCount, sizeof(float)));
+    
+    view.coins.count = header.coinCount;
+    view.coins.x = reinterpret_cast<const float*>(column(header.coinCount, sizeof(float)));
+    view.coins.y = reinterpret_cast<const float*>(column(header.coinCount, sizeof(float)));
+    
+    view.powerUps.count = header.powerUpCount;
+    view.powerUps.x = reinterpret_cast<const float*>(column(header.powerUpCount, sizeof(float)));
+    view.powerUps.y = reinterpret_cast<const float*>(column(header.powerUpCount, sizeof(float)));
+    view.powerUps.type = reinterpret_cast<const PowerUpType*>(column(header.powerUpCount, sizeof(PowerUpType)));
+    
+    view.emitters.count = header.emitterCount;
+    view.emitters.records = reinterpret_cast<const LevelLayout::EmitterRecord*>(
+        column(header.emitterCount, sizeof(LevelLayout::EmitterRecord)));
+    
+    // Chunk start tables follow in the same type order
+    const std::uint32_t** tables[ENTITY_TYPE_COUNT] = {
+        &view.platforms.chunkStart, &view.movingPlatforms.chunkStart, &view.enemies.chunkStart,
+        &view.coins.chunkStart, &view.powerUps.chunkStart, &view.emitters.chunkStart
+    };
+    const size_t counts[ENTITY_TYPE_COUNT] = {
+        view.platforms.count, view.movingPlatforms.count, view.enemies.count,
+        view.coins.count, view.powerUps.count, view.emitters.count
+    };
+    for (int type = 0; type < ENTITY_TYPE_COUNT; type++) {
+        const std::uint32_t* table = reinterpret_cast<const std::uint32_t*>(
+            column(view.chunkCount + 1, sizeof(std::uint32_t)));
+        if (table[0] != 0 || table[view.chunkCount] != counts[type]) {
+            return false;
+        }
+        for (size_t chunk = 0; chunk < view.chunkCount; chunk++) {
+            if (table[chunk] > table[chunk + 1]) {
+                return false;
+            }
+        }
+        *tables[type] = table;
+    }
+    
+    // The stores switch on these, so reject values outside the enums
+    for (size_t i = 0; i < view.movingPlatforms.count; i++) {
+        std::uint32_t type;
+        std::memcpy(&type, &view.movingPlatforms.type[i], sizeof(type));
+        if (type > static_cast<std::uint32_t>(MovementType::CIRCULAR)) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < view.powerUps.count; i++) {
+        std::uint32_t type;
+        std::memcpy(&type, &view.powerUps.type[i], sizeof(type));
+        if (type > static_cast<std::uint32_t>(PowerUpType::EXTRA_LIFE)) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < view.emitters.count; i++) {
+        std::uint32_t effect;
+        std::memcpy(&effect, &view.emitters.records[i].effect, sizeof(effect));
+        if (effect > static_cast<std::uint32_t>(ParticleEffect::POWER_UP)) {
+            return false;
+        }
+    }
+    
+    m_view = view;
+    return true;
+}
+
+void LevelFile::Compile(const LevelLayout& layout, ChunkTables& tables, std::vector<std::uint8_t>& image) {
+    size_t chunkCount = std::max<size_t>(1, static_cast<size_t>(std::ceil(layout.width / CHUNK_WIDTH)));
+    
+    std::vector<std::uint32_t>* order = tables.order;
+    std::vector<std::uint32_t>* chunkStart = tables.chunkStart;
+    SortIntoChunks(layout.platforms, chunkCount, order[0], chunkStart[0], tables.next);
+    SortIntoChunks(layout.movingPlatforms, chunkCount, order[1], chunkStart[1], tables.next);
+    SortIntoChunks(layout.enemies, chunkCount, order[2], chunkStart[2], tables.next);
+    SortIntoChunks(layout.coins, chunkCount, order[3], chunkStart[3], tables.next);
+    SortIntoChunks(layout.powerUps, chunkCount, order[4], chunkStart[4], tables.next);
+    SortIntoChunks(layout.emitters, chunkCount, order[5], chunkStart[5], tables.next);
+    
+    LevelFileHeader header;
+    std::memcpy(header.magic, LEVEL_MAGIC, sizeof(LEVEL_MAGIC));
+    header.version = VERSION;
+    header.byteOrder = LEVEL_BYTE_ORDER;
+    header.width = layout.width;
+    header.height = layout.height;
+    header.spawnX = layout.playerSpawn.x;
+    header.spawnY = layout.playerSpawn.y;
+    header.chunkWidth = CHUNK_WIDTH;
+    header.chunkCount = static_cast<std::uint32_t>(chunkCount);
+    header.platformCount = static_cast<std::uint32_t>(layout.platforms.size());
+    header.movingPlatformCount = static_cast<std::uint32_t>(layout.movingPlatforms.size());
+    header.enemyCount = static_cast<std::uint32_t>(layout.enemies.size());
+    header.coinCount = static_cast<std::uint32_t>(layout.coins.size());
+    header.powerUpCount = static_cast<std::uint32_t>(layout.powerUps.size());
+    header.emitterCount = static_cast<std::uint32_t>(layout.emitters.size());
+    
+    image.clear();
+    Append(image, &header, sizeof(header));
+    
+    typedef LevelLayout::PlatformRecord Platform;
+    AppendColumn(image, layout.platforms, order[0], &Platform::x);
+    AppendColumn(image, layout.platforms, order[0], &Platform::y);
+    AppendColumn(image, layout.platforms, order[0], &Platform::width);
+    AppendColumn(image, layout.platforms, order[0], &Platform::height);
+    
+    typedef LevelLayout::MovingPlatformRecord MovingPlatform;
+    AppendColumn(image, layout.movingPlatforms, order[1], &MovingPlatform::x);
+    AppendColumn(image, layout.movingPlatforms, order[1], &MovingPlatform::y);
+    AppendColumn(image, layout.movingPlatforms, order[1], &MovingPlatform::width);
+    AppendColumn(image, layout.movingPlatforms, order[1], &MovingPlatform::height);
+    AppendColumn(image, layout.movingPlatforms, order[1], &MovingPlatform::type);
+    AppendColumn(image, layout.movingPlatforms, order[1], &MovingPlatform::speed);
+    AppendColumn(image, layout.movingPlatforms, order[1], &MovingPlatform::range);
+    
+    AppendColumn(image, layout.enemies, order[2], &LevelLayout::EnemyRecord::x);
+    AppendColumn(image, layout.enemies, order[2], &LevelLayout::EnemyRecord::y);
+    
+    AppendColumn(image, layout.coins, order[3], &LevelLayout::CoinRecord::x);
+    AppendColumn(image, layout.coins, order[3], &LevelLayout::CoinRecord::y);
+    
+    AppendColumn(image, layout.powerUps, order[4], &LevelLayout::PowerUpRecord::x);
+    AppendColumn(image, layout.powerUps, order[4], &LevelLayout::PowerUpRecord::y);
+    AppendColumn(image, layout.powerUps, order[4], &LevelLayout::PowerUpRecord::type);
+    
+    for (std::uint32_t index : order[5]) {
+        Append(image, &layout.emitters[index], sizeof(LevelLayout::EmitterRecord));
+    }
+    
+    for (int type = 0; type < ENTITY_TYPE_COUNT; type++) {
+        Append(image, chunkStart[type].data(), chunkStart[type].size() * sizeof(std::uint32_t));
+    }
+}
+
+bool LevelFile::Write(const std::string& path, const LevelLayout& layout) {
+    std::vector<std::uint8_t> image;
+    ChunkTables tables;
+    Compile(layout, tables, image);
+    
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(image.data()), image.size());
+    return static_cast<bool>(file);
+}
\ No newline at end of file
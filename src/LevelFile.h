@@ -0,0 +1,117 @@
+#pragma once
+#include "LevelLayout.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Read-only columns of a level, one flat array per entity field. Records are
+// sorted into fixed-width chunks along x, and each type has a table of where
+// every chunk starts, so the entities of any run of chunks are one contiguous
+// slice of each column. Entity stores copy such slices with one bulk insert
+// per column. Only valid while the LevelFile it came from stays open.
+struct LevelView {
+    float width;
+    float height;
+    Vector2 playerSpawn;
+    float chunkWidth;
+    size_t chunkCount;
+    
+    // chunkStart[c] is the first record of chunk c; chunkStart[chunkCount] == count
+    struct Platforms {
+        size_t count;
+        const std::uint32_t* chunkStart;
+        const float* x;
+        const float* y;
+        const float* width;
+        const float* height;
+    } platforms;
+    
+    struct MovingPlatforms {
+        size_t count;
+        const std::uint32_t* chunkStart;
+        const float* x;
+        const float* y;
+        const float* width;
+        const float* height;
+        const MovementType* type;
+        const float* speed;
+        const float* range;
+    } movingPlatforms;
+    
+    struct Positions {
+        size_t count;
+        const std::uint32_t* chunkStart;
+        const float* x;
+        const float* y;
+    } enemies, coins;
+    
+    struct PowerUps {
+        size_t count;
+        const std::uint32_t* chunkStart;
+        const float* x;
+        const float* y;
+        const PowerUpType* type;
+    } powerUps;
+    
+    struct Emitters {
+        size_t count;
+        const std::uint32_t* chunkStart;
+        const LevelLayout::EmitterRecord* records;
+    } emitters;
+    
+    size_t CountEntities() const {
+        return platforms.count + movingPlatforms.count + enemies.count + coins.count +
+               powerUps.count + emitters.count;
+    }
+};
+
+// Compiled level (.mlvl, written by tools/LevelCompiler). Layout in native
+// byte order: a fixed header with the level size, spawn point, chunk size and
+// per-type counts, then every column back to back in LevelView order
+// (platform x[], y[], width[], height[], moving platform x[], ...), then the
+// chunk start tables, each 4-byte aligned.
+// Open() maps the file and points a LevelView at the columns in place, so
+// only the chunks that are actually streamed in are ever paged in. Levels
+// built in code go through the same format in memory with Build().
+class LevelFile {
+public:
+    LevelFile();
+    ~LevelFile();
+    LevelFile(const LevelFile&) = delete;
+    LevelFile& operator=(const LevelFile&) = delete;
+    
+    // Map a compiled level; fails on a wrong magic, version, byte order or size
+    bool Open(const std::string& path);
+    // Compile a layout into memory instead of reading a file
+    void Build(const LevelLayout& layout);
+    void Close();
+    bool IsOpen() const { return m_data != nullptr; }
+    
+    const LevelView& GetView() const { return m_view; }
+    
+    static bool Write(const std::string& path, const LevelLayout& layout);
+    
+    static const std::uint32_t VERSION = 2;
+    static const float CHUNK_WIDTH;
+    
+private:
+    static const int ENTITY_TYPE_COUNT = 6;  // One chunk start table per type
+    
+    // Records of every type in chunk order, and where each chunk starts
+    struct ChunkTables {
+        std::vector<std::uint32_t> order[ENTITY_TYPE_COUNT];
+        std::vector<std::uint32_t> chunkStart[ENTITY_TYPE_COUNT];
+        std::vector<std::uint32_t> next;  // Sorting scratch
+    };
+    
+    static void Compile(const LevelLayout& layout, ChunkTables& tables, std::vector<std::uint8_t>& image);
+    bool Map(const std::string& path);
+    bool BuildView();
+    
+    const std::uint8_t* m_data;
+    size_t m_size;
+    bool m_isMapped;
+    std::vector<std::uint8_t> m_buffer;  // Image for Build(), or the file contents where there is no mmap
+    ChunkTables m_tables;                // Kept so that building another level allocates nothing
+    LevelView m_view;
+};
\ No newline at end of file
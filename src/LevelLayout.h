@@ -0,0 +1,80 @@
+#pragma once
+#include "Types.h"
+#include "MovingPlatform.h"
+#include "PowerUp.h"
+#include <vector>
+
+// Effects a particle emitter can fire
+enum class ParticleEffect {
+    EXPLOSION,
+    COIN,
+    JUMP,
+    POWER_UP
+};
+
+// Plain description of a level's content. World::LoadLayout turns it into the
+// entity stores; the built-in levels and the scenario generator produce one of
+// these, and LevelFile::Write stores one as a compiled level file.
+struct LevelLayout {
+    struct PlatformRecord {
+        float x, y, width, height;
+    };
+    
+    struct MovingPlatformRecord {
+        float x, y, width, height;
+        MovementType type;
+        float speed;
+        float range;
+    };
+    
+    struct EnemyRecord {
+        float x, y;
+    };
+    
+    struct CoinRecord {
+        float x, y;
+    };
+    
+    struct PowerUpRecord {
+        float x, y;
+        PowerUpType type;
+    };
+    
+    struct EmitterRecord {
+        float x, y;
+        ParticleEffect effect;
+        float interval;  // Seconds between bursts
+    };
+    
+    float width;
+    float height;
+    Vector2 playerSpawn;
+    
+    std::vector<PlatformRecord> platforms;
+    std::vector<MovingPlatformRecord> movingPlatforms;
+    std::vector<EnemyRecord> enemies;
+    std::vector<CoinRecord> coins;
+    std::vector<PowerUpRecord> powerUps;
+    std::vector<EmitterRecord> emitters;
+    
+    LevelLayout(float levelWidth, float levelHeight, Vector2 spawn)
+        : width(levelWidth), height(levelHeight), playerSpawn(spawn) {}
+    
+    // Start describing another level; the record vectors keep their capacity
+    void Reset(float levelWidth, float levelHeight, Vector2 spawn) {
+        width = levelWidth;
+        height = levelHeight;
+        playerSpawn = spawn;
+        platforms.clear();
+        movingPlatforms.clear();
+        enemies.clear();
+        coins.clear();
+        powerUps.clear();
+        emitters.clear();
+    }
+    
+    size_t CountEntities() const {
+        return platforms.size() + movingPlatforms.size() + enemies.size() + coins.size() + 
+               powerUps.size() + emitters.size();
+    }
+};
\ No newline at end of file
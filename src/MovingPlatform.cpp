@@ -1,117 +1,249 @@
 #include "MovingPlatform.h"
+#include "StoreColumns.h"
+#include "FastTrig.h"
+#include <algorithm>
 #include <cmath>
 
-MovingPlatform::MovingPlatform(float x, float y, float width, float height, MovementType type, float speed, float range)
-    : m_position(x, y), m_startPosition(x, y), m_velocity(0, 0), m_bounds(x, y, width, height),
-      m_movementType(type), m_speed(speed), m_range(range), m_timer(0.0f), m_movingForward(true) {
+MovingPlatformStore::MovingPlatformStore(LevelArena* arena) 
+    : m_x(arena), m_y(arena), m_previousX(arena), m_previousY(arena), m_velocityX(arena), m_velocityY(arena), 
+      m_width(arena), m_height(arena), m_startX(arena), m_startY(arena), m_movementType(arena), 
+      m_speed(arena), m_range(arena), m_timer(arena), m_movingForward(arena), m_sleepTime(arena), 
+      m_keep(arena) {
 }
 
-void MovingPlatform::Update(float deltaTime) {
-    m_timer += deltaTime;
+void MovingPlatformStore::Clear() {
+    ReleaseColumn(m_x);
+    ReleaseColumn(m_y);
+    ReleaseColumn(m_previousX);
+    ReleaseColumn(m_previousY);
+    ReleaseColumn(m_velocityX);
+    ReleaseColumn(m_velocityY);
+    ReleaseColumn(m_width);
+    ReleaseColumn(m_height);
+    ReleaseColumn(m_startX);
+    ReleaseColumn(m_startY);
+    ReleaseColumn(m_movementType);
+    ReleaseColumn(m_speed);
+    ReleaseColumn(m_range);
+    ReleaseColumn(m_timer);
+    ReleaseColumn(m_movingForward);
+    ReleaseColumn(m_sleepTime);
+    ReleaseColumn(m_keep);
+}
+
+void MovingPlatformStore::Reserve(size_t count) {
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_previousX.reserve(count);
+    m_previousY.reserve(count);
+    m_velocityX.reserve(count);
+    m_velocityY.reserve(count);
+    m_width.reserve(count);
+    m_height.reserve(count);
+    m_startX.reserve(count);
+    m_startY.reserve(count);
+    m_movementType.reserve(count);
+    m_speed.reserve(count);
+    m_range.reserve(count);
+    m_timer.reserve(count);
+    m_movingForward.reserve(count);
+    m_sleepTime.reserve(count);
+    m_keep.reserve(count);
+}
+
+int MovingPlatformStore::Add(float x, float y, float width, float height, MovementType type, float speed, float range) {
+    m_x.push_back(x);
+    m_y.push_back(y);
+    m_previousX.push_back(x);
+    m_previousY.push_back(y);
+    m_velocityX.push_back(0.0f);
+    m_velocityY.push_back(0.0f);
+    m_width.push_back(width);
+    m_height.push_back(height);
+    m_startX.push_back(x);
+    m_startY.push_back(y);
+    m_movementType.push_back(type);
+    m_speed.push_back(speed);
+    m_range.push_back(range);
+    m_timer.push_back(0.0f);
+    m_movingForward.push_back(1);
+    m_sleepTime.push_back(0.0f);
+    return static_cast<int>(m_x.size()) - 1;
+}
+
+void MovingPlatformStore::AddRange(size_t count, const float* x, const float* y, const float* width, const float* height, 
+                                   const MovementType* type, const float* speed, const float* range) {
+    m_x.insert(m_x.end(), x, x + count);
+    m_y.insert(m_y.end(), y, y + count);
+    m_previousX.insert(m_previousX.end(), x, x + count);
+    m_previousY.insert(m_previousY.end(), y, y + count);
+    m_velocityX.insert(m_velocityX.end(), count, 0.0f);
+    m_velocityY.insert(m_velocityY.end(), count, 0.0f);
+    m_width.insert(m_width.end(), width, width + count);
+    m_height.insert(m_height.end(), height, height + count);
+    m_startX.insert(m_startX.end(), x, x + count);
+    m_startY.insert(m_startY.end(), y, y + count);
+    m_movementType.insert(m_movementType.end(), type, type + count);
+    m_speed.insert(m_speed.end(), speed, speed + count);
+    m_range.insert(m_range.end(), range, range + count);
+    m_timer.insert(m_timer.end(), count, 0.0f);
+    m_movingForward.insert(m_movingForward.end(), count, 1);
+    m_sleepTime.insert(m_sleepTime.end(), count, 0.0f);
+}
+
+size_t MovingPlatformStore::RemoveLeftOf(float x) {
+    size_t removed = MarkLeftOf(m_x, m_width, x, m_keep);
+    if (removed == 0) return 0;
     
-    switch (m_movementType) {
-        case MovementType::HORIZONTAL:
-            if (m_movingForward) {
-                m_velocity.x = m_speed;
-                if (m_position.x >= m_startPosition.x + m_range) {
-                    m_movingForward = false;
-                }
-            } else {
-                m_velocity.x = -m_speed;
-                if (m_position.x <= m_startPosition.x) {
-                    m_movingForward = true;
-                }
-            }
-            m_velocity.y = 0;
-            break;
-            
-        case MovementType::VERTICAL:
-            if (m_movingForward) {
-                m_velocity.y = -m_speed;
-                if (m_position.y <= m_startPosition.y - m_range) {
-                    m_movingForward = false;
-                }
-            } else {
-                m_velocity.y = m_speed;
-                if (m_position.y >= m_startPosition.y) {
-                    m_movingForward = true;
-                }
-            }
-            m_velocity.x = 0;
-            break;
-            
-        case MovementType::CIRCULAR:
-            {
-                float angle = m_timer * m_speed * 0.02f; // Slower circular motion
-                m_position.x = m_startPosition.x + cos(angle) * m_range;
-                m_position.y = m_startPosition.y + sin(angle) * m_range * 0.5f;
-                
-                // Calculate velocity for smooth player movement
-                float nextAngle = angle + deltaTime * m_speed * 0.02f;
-                Vector2 nextPos(m_startPosition.x + cos(nextAngle) * m_range,
-                               m_startPosition.y + sin(nextAngle) * m_range * 0.5f);
-                m_velocity = (nextPos - m_position) * (1.0f / deltaTime);
-            }
-            break;
+    CompactColumn(m_x, m_keep);
+    CompactColumn(m_y, m_keep);
+    CompactColumn(m_previousX, m_keep);
+    CompactColumn(m_previousY, m_keep);
+    CompactColumn(m_velocityX, m_keep);
+    CompactColumn(m_velocityY, m_keep);
+    CompactColumn(m_width, m_keep);
+    CompactColumn(m_height, m_keep);
+    CompactColumn(m_startX, m_keep);
+    CompactColumn(m_startY, m_keep);
+    CompactColumn(m_movementType, m_keep);
+    CompactColumn(m_speed, m_keep);
+    CompactColumn(m_range, m_keep);
+    CompactColumn(m_timer, m_keep);
+    CompactColumn(m_movingForward, m_keep);
+    CompactColumn(m_sleepTime, m_keep);
+    return removed;
+}
+
+void MovingPlatformStore::SaveState(StateWriter& out) const {
+    WriteColumns(out, m_x, m_y, m_previousX, m_previousY, m_velocityX, m_velocityY, m_width, m_height,
+                     m_startX, m_startY, m_movementType, m_speed, m_range, m_timer, m_movingForward, m_sleepTime);
+}
+
+bool MovingPlatformStore::LoadState(StateReader& in) {
+    if (!ReadColumns(in, m_x, m_y, m_previousX, m_previousY, m_velocityX, m_velocityY, m_width, m_height,
+                         m_startX, m_startY, m_movementType, m_speed, m_range, m_timer, m_movingForward, m_sleepTime) ||
+        !AllWithin(MAX_STATE_COORDINATE, m_x, m_y, m_previousX, m_previousY, m_width, m_height, m_startX, m_startY, m_range) ||
+        !AllFinite(m_velocityX, m_velocityY, m_speed, m_timer, m_sleepTime)) {
+        return false;
     }
     
-    if (m_movementType != MovementType::CIRCULAR) {
-        m_position = m_position + m_velocity * deltaTime;
+    // Update() switches on the movement type, so reject values outside the enum
+    for (MovementType type : m_movementType) {
+        if (static_cast<std::uint32_t>(type) > static_cast<std::uint32_t>(MovementType::CIRCULAR)) {
+            return false;
+        }
     }
-    
-    // Update bounds
-    m_bounds.x = m_position.x;
-    m_bounds.y = m_position.y;
+    return true;
 }
 
-void MovingPlatform::Render(SDL_Renderer* renderer) {
-    // Draw platform with a different color to distinguish from static platforms
-    SDL_SetRenderDrawColor(renderer, 100, 149, 237, 255); // Cornflower blue
-    SDL_Rect platformRect = {
-        static_cast<int>(m_bounds.x),
-        static_cast<int>(m_bounds.y),
-        static_cast<int>(m_bounds.width),
-        static_cast<int>(m_bounds.height)
-    };
-    SDL_RenderFillRect(renderer, &platformRect);
-    
-    // Draw platform border
-    SDL_SetRenderDrawColor(renderer, 65, 105, 225, 255); // Royal blue
-    SDL_RenderDrawRect(renderer, &platformRect);
-    
-    // Add movement indicator arrows
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    int centerX = static_cast<int>(m_bounds.x + m_bounds.width/2);
-    int centerY = static_cast<int>(m_bounds.y + m_bounds.height/2);
-    
-    if (m_movementType == MovementType::HORIZONTAL) {
-        // Draw left-right arrows
-        SDL_RenderDrawLine(renderer, centerX - 10, centerY, centerX + 10, centerY);
-        SDL_RenderDrawLine(renderer, centerX - 8, centerY - 2, centerX - 10, centerY);
-        SDL_RenderDrawLine(renderer, centerX - 8, centerY + 2, centerX - 10, centerY);
-        SDL_RenderDrawLine(renderer, centerX + 8, centerY - 2, centerX + 10, centerY);
-        SDL_RenderDrawLine(renderer, centerX + 8, centerY + 2, centerX + 10, centerY);
-    } else if (m_movementType == MovementType::VERTICAL) {
-        // Draw up-down arrows
-        SDL_RenderDrawLine(renderer, centerX, centerY - 10, centerX, centerY + 10);
-        SDL_RenderDrawLine(renderer, centerX - 2, centerY - 8, centerX, centerY - 10);
-        SDL_RenderDrawLine(renderer, centerX + 2, centerY - 8, centerX, centerY - 10);
-        SDL_RenderDrawLine(renderer, centerX - 2, centerY + 8, centerX, centerY + 10);
-        SDL_RenderDrawLine(renderer, centerX + 2, centerY + 8, centerX, centerY + 10);
-    } else {
-        // Draw circular arrow for circular movement
-        for (int i = 0; i < 8; i++) {
-            float angle1 = i * 3.14159f / 4;
-            float angle2 = (i + 1) * 3.14159f / 4;
-            int x1 = centerX + static_cast<int>(cos(angle1) * 8);
-            int y1 = centerY + static_cast<int>(sin(angle1) * 8);
-            int x2 = centerX + static_cast<int>(cos(angle2) * 8);
-            int y2 = centerY + static_cast<int>(sin(angle2) * 8);
-            SDL_RenderDrawLine(renderer, x1, y1, x2, y2);
+void MovingPlatformStore::StorePreviousState() {
+    m_previousX = m_x;
+    m_previousY = m_y;
+}
+
+void MovingPlatformStore::Update(float deltaTime, const Rectangle& activeArea, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        if (!GetBounds(static_cast<int>(i)).Intersects(activeArea)) {
+            m_sleepTime[i] += deltaTime;
+            continue;
+        }
+        if (m_sleepTime[i] > 0) {
+            CatchUp(i, deltaTime);
+        }
+        
+        m_timer[i] += deltaTime;
+        
+        switch (m_movementType[i]) {
+            case MovementType::HORIZONTAL:
+                if (m_movingForward[i]) {
+                    m_velocityX[i] = m_speed[i];
+                    if (m_x[i] >= m_startX[i] + m_range[i]) {
+                        m_movingForward[i] = 0;
+                    }
+                } else {
+                    m_velocityX[i] = -m_speed[i];
+                    if (m_x[i] <= m_startX[i]) {
+                        m_movingForward[i] = 1;
+                    }
+                }
+                m_velocityY[i] = 0;
+                break;
+                
+            case MovementType::VERTICAL:
+                if (m_movingForward[i]) {
+                    m_velocityY[i] = -m_speed[i];
+                    if (m_y[i] <= m_startY[i] - m_range[i]) {
+                        m_movingForward[i] = 0;
+                    }
+                } else {
+                    m_velocityY[i] = m_speed[i];
+                    if (m_y[i] >= m_startY[i]) {
+                        m_movingForward[i] = 1;
+                    }
+                }
+                m_velocityX[i] = 0;
+                break;
+                
+            case MovementType::CIRCULAR:
+                {
+                    float angle = m_timer[i] * m_speed[i] * 0.02f; // Slower circular motion
+                    float x = m_startX[i] + FastCos(angle) * m_range[i];
+                    float y = m_startY[i] + FastSin(angle) * m_range[i] * 0.5f;
+                    
+                    // Calculate velocity for smooth player movement
+                    float nextAngle = angle + deltaTime * m_speed[i] * 0.02f;
+                    float nextX = m_startX[i] + FastCos(nextAngle) * m_range[i];
+                    float nextY = m_startY[i] + FastSin(nextAngle) * m_range[i] * 0.5f;
+                    m_velocityX[i] = (nextX - x) * (1.0f / deltaTime);
+                    m_velocityY[i] = (nextY - y) * (1.0f / deltaTime);
+                    m_x[i] = x;
+                    m_y[i] = y;
+                }
+                break;
+        }
+        
+        if (m_movementType[i] != MovementType::CIRCULAR) {
+            m_x[i] += m_velocityX[i] * deltaTime;
+            m_y[i] += m_velocityY[i] * deltaTime;
         }
     }
 }
 
-Rectangle MovingPlatform::GetBounds() const {
-    return m_bounds;
-} 
\ No newline at end of file
+void MovingPlatformStore::CatchUp(size_t i, float deltaTime) {
+    float sleepTime = m_sleepTime[i];
+    m_sleepTime[i] = 0.0f;
+    m_timer[i] += sleepTime;
+    
+    if (m_movementType[i] == MovementType::CIRCULAR) {
+        // Position is a function of the timer
+        float angle = m_timer[i] * m_speed[i] * 0.02f;
+        m_x[i] = m_startX[i] + FastCos(angle) * m_range[i];
+        m_y[i] = m_startY[i] + FastSin(angle) * m_range[i] * 0.5f;
+    } else if (m_speed[i] > 0.0f) {
+        // Update() moves one step per tick and only turns around on the tick
+        // after passing an end, so the platform swings between one step short
+        // of the start and one step past the first multiple of the step >= range.
+        // Fold the distance travelled while asleep into that cycle.
+        bool horizontal = m_movementType[i] == MovementType::HORIZONTAL;
+        float step = m_speed[i] * deltaTime;
+        float span = (std::ceil(m_range[i] / step) + 2.0f) * step;
+        float cycle = 2.0f * span;
+        
+        float offset = (horizontal ? m_x[i] - m_startX[i] : m_startY[i] - m_y[i]) + step;
+        offset = std::min(std::max(offset, 0.0f), span);
+        float progress = m_movingForward[i] ? offset : cycle - offset;
+        progress = fmod(progress + m_speed[i] * sleepTime, cycle);
+        
+        m_movingForward[i] = progress < span;
+        offset = (m_movingForward[i] ? progress : cycle - progress) - step;
+        if (horizontal) {
+            m_x[i] = m_startX[i] + offset;
+        } else {
+            m_y[i] = m_startY[i] - offset;
+        }
+    }
+    
+    // Don't interpolate across the jump
+    m_previousX[i] = m_x[i];
+    m_previousY[i] = m_y[i];
+}
\ No newline at end of file
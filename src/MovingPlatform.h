@@ -1,6 +1,12 @@
 #pragma once
-#include "Game.h"
-#include <SDL2/SDL.h>
+#include "Types.h"
+#include "LevelArena.h"
+#include <vector>
+#include <cstdint>
+
+class RenderQueue;
+class StateWriter;
+class StateReader;
 
 enum class MovementType {
     HORIZONTAL,
@@ -8,23 +14,62 @@ enum class MovementType {
     CIRCULAR
 };
 
-class MovingPlatform {
+// Moving platforms stored as parallel arrays (structure of arrays).
+// Hot per-tick data (position, velocity, size) is kept apart from the
+// movement parameters that are only read by Update.
+class MovingPlatformStore {
 public:
-    MovingPlatform(float x, float y, float width, float height, MovementType type, float speed = 50.0f, float range = 100.0f);
+    // Columns take their storage from arena when given (it must outlive the store), else from the heap
+    explicit MovingPlatformStore(LevelArena* arena = nullptr);
+    
+    // Remove every entity and give the storage back, e.g. before the arena is reset
+    void Clear();
+    void Reserve(size_t count);
+    int Add(float x, float y, float width, float height, MovementType type, float speed = 50.0f, float range = 100.0f);
+    void AddRange(size_t count, const float* x, const float* y, const float* width, const float* height, 
+                  const MovementType* type, const float* speed, const float* range);
+    size_t RemoveLeftOf(float x);
+    size_t Size() const { return m_x.size(); }
+    
+    // Write every column to a saved-state image, or replace them with the ones read from it
+    void SaveState(StateWriter& out) const;
+    bool LoadState(StateReader& in);
+    
+    // Platforms outside activeArea sleep and are caught up analytically when they wake
+    void Update(float deltaTime, const Rectangle& activeArea) { Update(deltaTime, activeArea, 0, Size()); }
+    // Only platforms [begin, end); disjoint ranges may be updated in parallel
+    void Update(float deltaTime, const Rectangle& activeArea, size_t begin, size_t end);
+    // Only platforms that intersect view are drawn
+    void Render(RenderQueue& queue, const Rectangle& view, float alpha = 1.0f) const;
     
-    void Update(float deltaTime);
-    void Render(SDL_Renderer* renderer);
-    Rectangle GetBounds() const;
-    Vector2 GetVelocity() const { return m_velocity; }
+    // Remember current positions as the start of the next interpolation span
+    void StorePreviousState();
+    
+    Rectangle GetBounds(int index) const { return Rectangle(m_x[index], m_y[index], m_width[index], m_height[index]); }
+    Rectangle GetPreviousBounds(int index) const { return Rectangle(m_previousX[index], m_previousY[index], m_width[index], m_height[index]); }
+    Vector2 GetVelocity(int index) const { return Vector2(m_velocityX[index], m_velocityY[index]); }
     
 private:
-    Vector2 m_position;
-    Vector2 m_startPosition;
-    Vector2 m_velocity;
-    Rectangle m_bounds;
-    MovementType m_movementType;
-    float m_speed;
-    float m_range;
-    float m_timer;
-    bool m_movingForward;
-}; 
\ No newline at end of file
+    // Hot data
+    ArenaVector<float> m_x;
+    ArenaVector<float> m_y;
+    ArenaVector<float> m_previousX;
+    ArenaVector<float> m_previousY;
+    ArenaVector<float> m_velocityX;
+    ArenaVector<float> m_velocityY;
+    ArenaVector<float> m_width;
+    ArenaVector<float> m_height;
+    
+    // Movement parameters
+    ArenaVector<float> m_startX;
+    ArenaVector<float> m_startY;
+    ArenaVector<MovementType> m_movementType;
+    ArenaVector<float> m_speed;
+    ArenaVector<float> m_range;
+    ArenaVector<float> m_timer;
+    ArenaVector<std::uint8_t> m_movingForward;
+    ArenaVector<float> m_sleepTime;  // Time missed while outside the active area
+    ArenaVector<std::uint8_t> m_keep;  // RemoveLeftOf() scratch
+    
+    void CatchUp(size_t index, float deltaTime);
+};
@@ -0,0 +1,73 @@
+#include "MovingPlatform.h"
+#include "RenderQueue.h"
+#include <cmath>
+
+// Circular arrow drawn on circular platforms: an octagon of radius 8 around
+// the centre, the same for every platform, so its corners are computed once
+struct Octagon {
+    int x[9];
+    int y[9];
+};
+
+static Octagon MakeOctagon() {
+    Octagon octagon;
+    for (int corner = 0; corner <= 8; corner++) {
+        float angle = corner * 3.14159f / 4;
+        octagon.x[corner] = static_cast<int>(cos(angle) * 8);
+        octagon.y[corner] = static_cast<int>(sin(angle) * 8);
+    }
+    return octagon;
+}
+
+void MovingPlatformStore::Render(RenderQueue& queue, const Rectangle& view, float alpha) const {
+    queue.SetLayer(RenderLayer::MOVING_PLATFORMS);
+    
+    for (size_t i = 0; i < m_x.size(); i++) {
+        Vector2 position = Lerp(Vector2(m_previousX[i], m_previousY[i]), Vector2(m_x[i], m_y[i]), alpha);
+        if (!Rectangle(position.x, position.y, m_width[i], m_height[i]).Intersects(view)) continue;
+        
+        queue.BeginItem();
+        
+        // Draw platform with a different color to distinguish from static platforms
+        queue.SetDrawColor(100, 149, 237, 255); // Cornflower blue
+        SDL_Rect platformRect = {
+            static_cast<int>(position.x),
+            static_cast<int>(position.y),
+            static_cast<int>(m_width[i]),
+            static_cast<int>(m_height[i])
+        };
+        queue.FillRect(platformRect);
+        
+        // Draw platform border
+        queue.SetDrawColor(65, 105, 225, 255); // Royal blue
+        queue.DrawRect(platformRect);
+        
+        // Add movement indicator arrows
+        queue.SetDrawColor(255, 255, 255, 255);
+        int centerX = static_cast<int>(position.x + m_width[i]/2);
+        int centerY = static_cast<int>(position.y + m_height[i]/2);
+        
+        if (m_movementType[i] == MovementType::HORIZONTAL) {
+            // Draw left-right arrows
+            queue.DrawLine(centerX - 10, centerY, centerX + 10, centerY);
+            queue.DrawLine(centerX - 8, centerY - 2, centerX - 10, centerY);
+            queue.DrawLine(centerX - 8, centerY + 2, centerX - 10, centerY);
+            queue.DrawLine(centerX + 8, centerY - 2, centerX + 10, centerY);
+            queue.DrawLine(centerX + 8, centerY + 2, centerX + 10, centerY);
+        } else if (m_movementType[i] == MovementType::VERTICAL) {
+            // Draw up-down arrows
+            queue.DrawLine(centerX, centerY - 10, centerX, centerY + 10);
+            queue.DrawLine(centerX - 2, centerY - 8, centerX, centerY - 10);
+            queue.DrawLine(centerX + 2, centerY - 8, centerX, centerY - 10);
+            queue.DrawLine(centerX - 2, centerY + 8, centerX, centerY + 10);
+            queue.DrawLine(centerX + 2, centerY + 8, centerX, centerY + 10);
+        } else {
+            // Draw circular arrow for circular movement
+            static const Octagon octagon = MakeOctagon();
+            for (int segment = 0; segment < 8; segment++) {
+                queue.DrawLine(centerX + octagon.x[segment], centerY + octagon.y[segment],
+                               centerX + octagon.x[segment + 1], centerY + octagon.y[segment + 1]);
+            }
+        }
+    }
+}
@@ -1,115 +1,252 @@
 #include "ParticleSystem.h"
+#include "JobSystem.h"
+#include "FastTrig.h"
+#include "StoreColumns.h"
 #include <algorithm>
 #include <cmath>
-#include <random>
 
-ParticleSystem::ParticleSystem() {
-    m_particles.reserve(1000); // Pre-allocate for performance
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static const float PARTICLE_GRAVITY = 300.0f;
+static const float GRAVITY_CUTOFF_SPEED = -200.0f; // Upward-flying particles ignore gravity
+static const size_t UPDATE_BATCH_SIZE = 2048;       // Multiple of every vector width
+
+ParticleSystem::ParticleSystem(size_t capacity) 
+    : m_capacity(capacity), m_count(0), m_random(0, RandomStream::PARTICLES) {
+    // Allocate the whole pool up front - no allocation happens after this
+    m_x.resize(capacity);
+    m_y.resize(capacity);
+    m_previousX.resize(capacity);
+    m_previousY.resize(capacity);
+    m_velocityX.resize(capacity);
+    m_velocityY.resize(capacity);
+    m_life.resize(capacity);
+    m_inverseMaxLife.resize(capacity);
+    m_alpha.resize(capacity);
+    m_size.resize(capacity);
+    m_red.resize(capacity);
+    m_green.resize(capacity);
+    m_blue.resize(capacity);
+}
+
+void ParticleSystem::Seed(std::uint32_t seed) {
+    m_random.Seed(seed, RandomStream::PARTICLES);
+}
+
+void ParticleSystem::CopyRenderState(const ParticleSystem& source) {
+    m_count = std::min(source.m_count, m_capacity);
+    std::copy_n(source.m_x.begin(), m_count, m_x.begin());
+    std::copy_n(source.m_y.begin(), m_count, m_y.begin());
+    std::copy_n(source.m_previousX.begin(), m_count, m_previousX.begin());
+    std::copy_n(source.m_previousY.begin(), m_count, m_previousY.begin());
+    std::copy_n(source.m_alpha.begin(), m_count, m_alpha.begin());
+    std::copy_n(source.m_size.begin(), m_count, m_size.begin());
+    std::copy_n(source.m_red.begin(), m_count, m_red.begin());
+    std::copy_n(source.m_green.begin(), m_count, m_green.begin());
+    std::copy_n(source.m_blue.begin(), m_count, m_blue.begin());
+}
+
+void ParticleSystem::SaveState(StateWriter& out) const {
+    out.Write(m_random);
+    for (const std::vector<float>* column : {&m_x, &m_y, &m_previousX, &m_previousY, &m_velocityX, &m_velocityY,
+                                             &m_life, &m_inverseMaxLife, &m_alpha, &m_size}) {
+        out.WriteArray(column->data(), m_count);
+    }
+    for (const std::vector<std::uint8_t>* column : {&m_red, &m_green, &m_blue}) {
+        out.WriteArray(column->data(), m_count);
+    }
+}
+
+bool ParticleSystem::LoadState(StateReader& in) {
+    // Columns stay allocated at full capacity; only the live prefix is replaced
+    m_count = 0;
+    size_t count = 0;
+    if (!in.Read(m_random) || !in.ReadArray(m_x.data(), m_capacity, count)) {
+        return false;
+    }
+    size_t columnCount = 0;
+    for (std::vector<float>* column : {&m_y, &m_previousX, &m_previousY, &m_velocityX, &m_velocityY,
+                                       &m_life, &m_inverseMaxLife, &m_alpha, &m_size}) {
+        if (!in.ReadArray(column->data(), count, columnCount) || columnCount != count) return false;
+    }
+    for (std::vector<std::uint8_t>* column : {&m_red, &m_green, &m_blue}) {
+        if (!in.ReadArray(column->data(), count, columnCount) || columnCount != count) return false;
+    }
+    
+    // Render() turns positions and sizes into pixels and alpha into a byte,
+    // and Update() recomputes alpha from the life left, so keep all of them to
+    // what play can produce
+    for (size_t i = 0; i < count; i++) {
+        float fade = 255.0f * m_life[i] * m_inverseMaxLife[i];
+        for (float value : {m_x[i], m_y[i], m_previousX[i], m_previousY[i], m_velocityX[i], m_velocityY[i], m_size[i]}) {
+            if (!(std::abs(value) <= MAX_STATE_COORDINATE)) return false;
+        }
+        if (!std::isfinite(m_life[i]) || !std::isfinite(m_inverseMaxLife[i]) || !(fade < 256.0f) ||
+            !(m_alpha[i] >= 0.0f && m_alpha[i] <= 255.0f)) {
+            return false;
+        }
+    }
+    m_count = count;
+    return true;
+}
+
+void ParticleSystem::Update(float deltaTime, JobSystem* jobs) {
+    // Batches start on vector boundaries, so every particle takes the same
+    // path through the kernel however the pool is split
+    ParallelFor(jobs, m_count, UPDATE_BATCH_SIZE, [this, deltaTime](size_t, size_t begin, size_t end) {
+        size_t processed = UpdateSimd(begin, end, deltaTime);
+        UpdateScalar(processed, end, deltaTime);
+    });
+    
+    RemoveDeadParticles();
 }
 
-void ParticleSystem::Update(float deltaTime) {
-    // Update all particles
-    for (auto& particle : m_particles) {
-        particle.life -= deltaTime;
-        particle.position = particle.position + particle.velocity * deltaTime;
+void ParticleSystem::UpdateScalar(size_t begin, size_t end, float deltaTime) {
+    const float gravityStep = PARTICLE_GRAVITY * deltaTime;
+    for (size_t i = begin; i < end; i++) {
+        m_life[i] -= deltaTime;
+        m_previousX[i] = m_x[i];
+        m_previousY[i] = m_y[i];
+        m_x[i] += m_velocityX[i] * deltaTime;
+        m_y[i] += m_velocityY[i] * deltaTime;
         
         // Apply gravity to some particles
-        if (particle.velocity.y > -200) { // Not for upward-flying particles
-            particle.velocity.y += 300.0f * deltaTime; // Gravity
+        if (m_velocityY[i] > GRAVITY_CUTOFF_SPEED) {
+            m_velocityY[i] += gravityStep;
         }
         
         // Fade out particles as they age
-        float lifeRatio = particle.life / particle.maxLife;
-        particle.color.a = static_cast<Uint8>(255 * lifeRatio);
+        m_alpha[i] = std::max(0.0f, 255.0f * m_life[i] * m_inverseMaxLife[i]);
     }
-    
-    RemoveDeadParticles();
 }
 
-void ParticleSystem::Render(SDL_Renderer* renderer) {
-    for (const auto& particle : m_particles) {
-        SDL_SetRenderDrawColor(renderer, particle.color.r, particle.color.g, particle.color.b, particle.color.a);
+#if defined(__AVX2__)
+size_t ParticleSystem::UpdateSimd(size_t begin, size_t end, float deltaTime) {
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    const __m256 gravityStep = _mm256_set1_ps(PARTICLE_GRAVITY * deltaTime);
+    const __m256 cutoff = _mm256_set1_ps(GRAVITY_CUTOFF_SPEED);
+    const __m256 full = _mm256_set1_ps(255.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 life = _mm256_sub_ps(_mm256_loadu_ps(&m_life[i]), dt);
+        __m256 x = _mm256_loadu_ps(&m_x[i]);
+        __m256 y = _mm256_loadu_ps(&m_y[i]);
+        __m256 vx = _mm256_loadu_ps(&m_velocityX[i]);
+        __m256 vy = _mm256_loadu_ps(&m_velocityY[i]);
+        
+        _mm256_storeu_ps(&m_previousX[i], x);
+        _mm256_storeu_ps(&m_previousY[i], y);
+        _mm256_storeu_ps(&m_x[i], _mm256_add_ps(x, _mm256_mul_ps(vx, dt)));
+        _mm256_storeu_ps(&m_y[i], _mm256_add_ps(y, _mm256_mul_ps(vy, dt)));
+        
+        __m256 falling = _mm256_cmp_ps(vy, cutoff, _CMP_GT_OQ);
+        _mm256_storeu_ps(&m_velocityY[i], _mm256_add_ps(vy, _mm256_and_ps(falling, gravityStep)));
         
-        // Draw particle as a small rectangle
-        SDL_Rect particleRect = {
-            static_cast<int>(particle.position.x - particle.size/2),
-            static_cast<int>(particle.position.y - particle.size/2),
-            static_cast<int>(particle.size),
-            static_cast<int>(particle.size)
-        };
-        SDL_RenderFillRect(renderer, &particleRect);
+        __m256 fade = _mm256_mul_ps(_mm256_mul_ps(full, life), _mm256_loadu_ps(&m_inverseMaxLife[i]));
+        _mm256_storeu_ps(&m_alpha[i], _mm256_max_ps(fade, zero));
+        _mm256_storeu_ps(&m_life[i], life);
+    }
+    return i;
+}
+#elif defined(__SSE2__)
+size_t ParticleSystem::UpdateSimd(size_t begin, size_t end, float deltaTime) {
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 gravityStep = _mm_set1_ps(PARTICLE_GRAVITY * deltaTime);
+    const __m128 cutoff = _mm_set1_ps(GRAVITY_CUTOFF_SPEED);
+    const __m128 full = _mm_set1_ps(255.0f);
+    const __m128 zero = _mm_setzero_ps();
+    
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 life = _mm_sub_ps(_mm_loadu_ps(&m_life[i]), dt);
+        __m128 x = _mm_loadu_ps(&m_x[i]);
+        __m128 y = _mm_loadu_ps(&m_y[i]);
+        __m128 vx = _mm_loadu_ps(&m_velocityX[i]);
+        __m128 vy = _mm_loadu_ps(&m_velocityY[i]);
+        
+        _mm_storeu_ps(&m_previousX[i], x);
+        _mm_storeu_ps(&m_previousY[i], y);
+        _mm_storeu_ps(&m_x[i], _mm_add_ps(x, _mm_mul_ps(vx, dt)));
+        _mm_storeu_ps(&m_y[i], _mm_add_ps(y, _mm_mul_ps(vy, dt)));
+        
+        __m128 falling = _mm_cmpgt_ps(vy, cutoff);
+        _mm_storeu_ps(&m_velocityY[i], _mm_add_ps(vy, _mm_and_ps(falling, gravityStep)));
+        
+        __m128 fade = _mm_mul_ps(_mm_mul_ps(full, life), _mm_loadu_ps(&m_inverseMaxLife[i]));
+        _mm_storeu_ps(&m_alpha[i], _mm_max_ps(fade, zero));
+        _mm_storeu_ps(&m_life[i], life);
+    }
+    return i;
+}
+#else
+size_t ParticleSystem::UpdateSimd(size_t begin, size_t end, float deltaTime) {
+    (void)end;
+    (void)deltaTime;
+    return begin; // No vector unit available - the scalar loop handles everything
+}
+#endif
+
+void ParticleSystem::RandomVelocities(size_t count, float angleA, float angleB, float speedA, float speedB, 
+                                      float* velocityX, float* velocityY) {
+    float angles[MAX_BURST];
+    float speeds[MAX_BURST];
+    m_random.Fill(angles, count, angleA, angleB);
+    m_random.Fill(speeds, count, speedA, speedB);
+    for (size_t i = 0; i < count; i++) {
+        velocityX[i] = FastCos(angles[i]) * speeds[i];
+        velocityY[i] = FastSin(angles[i]) * speeds[i];
     }
 }
 
 void ParticleSystem::CreateExplosion(Vector2 position, Color color) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<float> angleDist(0, 2 * 3.14159f);
-    static std::uniform_real_distribution<float> speedDist(50, 150);
-    static std::uniform_real_distribution<float> lifeDist(0.5f, 1.2f);
-    
     // Create 15-25 particles for explosion
-    int particleCount = 15 + (gen() % 11);
-    for (int i = 0; i < particleCount; i++) {
-        float angle = angleDist(gen);
-        float speed = speedDist(gen);
-        Vector2 velocity(cos(angle) * speed, sin(angle) * speed);
-        float life = lifeDist(gen);
-        
-        AddParticle(Particle(position, velocity, color, life, 4.0f));
+    size_t particleCount = static_cast<size_t>(m_random.NextInt(15, 25));
+    float velocityX[MAX_BURST], velocityY[MAX_BURST], life[MAX_BURST];
+    RandomVelocities(particleCount, 0, 2 * 3.14159f, 50, 150, velocityX, velocityY);
+    m_random.Fill(life, particleCount, 0.5f, 1.2f);
+    
+    for (size_t i = 0; i < particleCount; i++) {
+        AddParticle(Particle(position, Vector2(velocityX[i], velocityY[i]), color, life[i], 4.0f));
     }
 }
 
 void ParticleSystem::CreateCoinEffect(Vector2 position) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<float> angleDist(-3.14159f/4, -3*3.14159f/4);
-    static std::uniform_real_distribution<float> speedDist(80, 120);
+    // Create sparkling coin effect: 8 gold sparkles, then 5 slower white ones
+    const size_t goldCount = 8;
+    const size_t particleCount = goldCount + 5;
+    float velocityX[MAX_BURST], velocityY[MAX_BURST];
+    RandomVelocities(particleCount, -3.14159f/4, -3*3.14159f/4, 80, 120, velocityX, velocityY);
     
-    // Create sparkling coin effect
-    for (int i = 0; i < 8; i++) {
-        float angle = angleDist(gen);
-        float speed = speedDist(gen);
-        Vector2 velocity(cos(angle) * speed, sin(angle) * speed);
+    for (size_t i = 0; i < goldCount; i++) {
         Color sparkleColor(255, 215, 0); // Gold
-        
-        AddParticle(Particle(position, velocity, sparkleColor, 1.0f, 3.0f));
+        AddParticle(Particle(position, Vector2(velocityX[i], velocityY[i]), sparkleColor, 1.0f, 3.0f));
     }
-    
-    // Add some white sparkles
-    for (int i = 0; i < 5; i++) {
-        float angle = angleDist(gen);
-        float speed = speedDist(gen) * 0.7f;
-        Vector2 velocity(cos(angle) * speed, sin(angle) * speed);
+    for (size_t i = goldCount; i < particleCount; i++) {
+        Vector2 velocity = Vector2(velocityX[i], velocityY[i]) * 0.7f;
         Color sparkleColor(255, 255, 255); // White
-        
         AddParticle(Particle(position, velocity, sparkleColor, 0.8f, 2.0f));
     }
 }
 
 void ParticleSystem::CreateJumpEffect(Vector2 position) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<float> angleDist(3.14159f/6, 5*3.14159f/6);
-    static std::uniform_real_distribution<float> speedDist(30, 60);
-    
     // Create dust particles when jumping
-    for (int i = 0; i < 6; i++) {
-        float angle = angleDist(gen);
-        float speed = speedDist(gen);
-        Vector2 velocity(cos(angle) * speed, sin(angle) * speed);
+    const size_t particleCount = 6;
+    float velocityX[MAX_BURST], velocityY[MAX_BURST];
+    RandomVelocities(particleCount, 3.14159f/6, 5*3.14159f/6, 30, 60, velocityX, velocityY);
+    
+    for (size_t i = 0; i < particleCount; i++) {
         Color dustColor(139, 69, 19, 180); // Brown dust
-        
-        AddParticle(Particle(position, velocity, dustColor, 0.6f, 3.0f));
+        AddParticle(Particle(position, Vector2(velocityX[i], velocityY[i]), dustColor, 0.6f, 3.0f));
     }
 }
 
 void ParticleSystem::CreatePowerUpEffect(Vector2 position) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<float> angleDist(0, 2 * 3.14159f);
-    static std::uniform_real_distribution<float> speedDist(20, 80);
-    
     // Create colorful power-up effect
     Color colors[] = {
         Color(255, 0, 255),   // Magenta
@@ -119,24 +256,60 @@ void ParticleSystem::CreatePowerUpEffect(Vector2 position) {
         Color(255, 0, 0)      // Red
     };
     
-    for (int i = 0; i < 12; i++) {
-        float angle = angleDist(gen);
-        float speed = speedDist(gen);
-        Vector2 velocity(cos(angle) * speed, sin(angle) * speed);
+    const size_t particleCount = 12;
+    float velocityX[MAX_BURST], velocityY[MAX_BURST];
+    RandomVelocities(particleCount, 0, 2 * 3.14159f, 20, 80, velocityX, velocityY);
+    
+    for (size_t i = 0; i < particleCount; i++) {
         Color color = colors[i % 5];
-        
-        AddParticle(Particle(position, velocity, color, 1.5f, 4.0f));
+        AddParticle(Particle(position, Vector2(velocityX[i], velocityY[i]), color, 1.5f, 4.0f));
     }
 }
 
-void ParticleSystem::AddParticle(const Particle& particle) {
-    m_particles.push_back(particle);
+bool ParticleSystem::AddParticle(const Particle& particle) {
+    if (m_count >= m_capacity || particle.life <= 0) {
+        return false;
+    }
+    
+    size_t i = m_count++;
+    m_x[i] = particle.position.x;
+    m_y[i] = particle.position.y;
+    m_previousX[i] = particle.position.x;
+    m_previousY[i] = particle.position.y;
+    m_velocityX[i] = particle.velocity.x;
+    m_velocityY[i] = particle.velocity.y;
+    m_life[i] = particle.life;
+    m_inverseMaxLife[i] = 1.0f / particle.life;
+    m_alpha[i] = particle.color.a;
+    m_size[i] = particle.size;
+    m_red[i] = particle.color.r;
+    m_green[i] = particle.color.g;
+    m_blue[i] = particle.color.b;
+    return true;
 }
 
 void ParticleSystem::RemoveDeadParticles() {
-    m_particles.erase(
-        std::remove_if(m_particles.begin(), m_particles.end(),
-            [](const Particle& p) { return p.life <= 0; }),
-        m_particles.end()
-    );
-} 
\ No newline at end of file
+    // Swap-with-last removal: order is not preserved, but nothing is shifted
+    size_t i = 0;
+    while (i < m_count) {
+        if (m_life[i] > 0) {
+            i++;
+            continue;
+        }
+        
+        size_t last = --m_count;
+        m_x[i] = m_x[last];
+        m_y[i] = m_y[last];
+        m_previousX[i] = m_previousX[last];
+        m_previousY[i] = m_previousY[last];
+        m_velocityX[i] = m_velocityX[last];
+        m_velocityY[i] = m_velocityY[last];
+        m_life[i] = m_life[last];
+        m_inverseMaxLife[i] = m_inverseMaxLife[last];
+        m_alpha[i] = m_alpha[last];
+        m_size[i] = m_size[last];
+        m_red[i] = m_red[last];
+        m_green[i] = m_green[last];
+        m_blue[i] = m_blue[last];
+    }
+}
\ No newline at end of file
@@ -1,26 +1,38 @@
 #pragma once
-#include "Game.h"
-#include <SDL2/SDL.h>
+#include "Types.h"
+#include "Random.h"
 #include <vector>
+#include <cstdint>
 
+class RenderQueue;
+class JobSystem;
+class StateWriter;
+class StateReader;
+
+// Spawn parameters for a single particle
 struct Particle {
     Vector2 position;
     Vector2 velocity;
     Color color;
     float life;
-    float maxLife;
     float size;
     
     Particle(Vector2 pos, Vector2 vel, Color col, float lifetime, float particleSize = 3.0f)
-        : position(pos), velocity(vel), color(col), life(lifetime), maxLife(lifetime), size(particleSize) {}
+        : position(pos), velocity(vel), color(col), life(lifetime), size(particleSize) {}
 };
 
+// Fixed-capacity particle pool stored as structure of arrays.
+// Live particles occupy [0, count); dead ones are removed by moving the last
+// live particle into their slot, so no per-frame compaction is needed.
+// The update kernel is vectorized with AVX2 or SSE2 when the compiler
+// targets them and falls back to scalar code otherwise.
 class ParticleSystem {
 public:
-    ParticleSystem();
+    explicit ParticleSystem(size_t capacity = DEFAULT_CAPACITY);
     
-    void Update(float deltaTime);
-    void Render(SDL_Renderer* renderer);
+    // The integration kernel runs in parallel batches when given a job system
+    void Update(float deltaTime, JobSystem* jobs = nullptr);
+    void Render(RenderQueue& queue, float alpha = 1.0f) const;
     
     // Effect creation methods
     void CreateExplosion(Vector2 position, Color color = Color(255, 100, 0));
@@ -28,9 +40,65 @@ public:
     void CreateJumpEffect(Vector2 position);
     void CreatePowerUpEffect(Vector2 position);
     
-private:
-    std::vector<Particle> m_particles;
+    // Returns false when the pool is full and the particle was dropped
+    bool AddParticle(const Particle& particle);
+    void Clear() { m_count = 0; }
+    
+    // Copy what Render() reads of source's live particles, e.g. into a render snapshot
+    void CopyRenderState(const ParticleSystem& source);
+    
+    // Write the live particles and the random stream to a saved-state image,
+    // or replace them with the ones read from it (at most the capacity)
+    void SaveState(StateWriter& out) const;
+    bool LoadState(StateReader& in);
+    // The random stream on its own, e.g. to put it back after a failed load
+    const Random& GetRandom() const { return m_random; }
+    void SetRandom(const Random& random) { m_random = random; }
+    
+    // Effects are randomized from the particle stream of the session seed (0
+    // until seeded), so the same seed repeats them exactly (e.g. input replays)
+    void Seed(std::uint32_t seed);
+    
+    size_t GetCount() const { return m_count; }
+    size_t GetCapacity() const { return m_capacity; }
+    
+    // Far above what the game's effects keep alive at once; every world and
+    // render snapshot allocates a full pool, so bigger counts (the benchmarks
+    // go to 100k) pass their own capacity
+    static const size_t DEFAULT_CAPACITY = 16384;
     
-    void AddParticle(const Particle& particle);
+private:
+    // Integrate, apply gravity and fade particles [begin, end)
+    void UpdateScalar(size_t begin, size_t end, float deltaTime);
+    // Vectorized part of [begin, end); returns where the scalar tail starts
+    size_t UpdateSimd(size_t begin, size_t end, float deltaTime);
     void RemoveDeadParticles();
-}; 
\ No newline at end of file
+    
+    // Random velocities for a burst of count (at most MAX_BURST) particles:
+    // directions between the two angles, speeds between the two speeds
+    void RandomVelocities(size_t count, float angleA, float angleB, float speedA, float speedB, 
+                          float* velocityX, float* velocityY);
+    
+    static const size_t MAX_BURST = 32;
+    
+    size_t m_capacity;
+    size_t m_count;
+    Random m_random;
+    
+    // Simulation data (one entry per slot)
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_previousX;
+    std::vector<float> m_previousY;
+    std::vector<float> m_velocityX;
+    std::vector<float> m_velocityY;
+    std::vector<float> m_life;
+    std::vector<float> m_inverseMaxLife;
+    std::vector<float> m_alpha;  // 0-255, written by the fade step
+    
+    // Render-only data
+    std::vector<float> m_size;
+    std::vector<std::uint8_t> m_red;
+    std::vector<std::uint8_t> m_green;
+    std::vector<std::uint8_t> m_blue;
+};
\ No newline at end of file
@@ -0,0 +1,21 @@
+#include "ParticleSystem.h"
+#include "RenderQueue.h"
+
+void ParticleSystem::Render(RenderQueue& queue, float alpha) const {
+    queue.SetLayer(RenderLayer::PARTICLES);
+    
+    for (size_t i = 0; i < m_count; i++) {
+        queue.BeginItem();
+        queue.SetDrawColor(m_red[i], m_green[i], m_blue[i], static_cast<Uint8>(m_alpha[i]));
+        
+        // Draw particle as a small rectangle (batched with all other particles regardless of colour)
+        Vector2 position = Lerp(Vector2(m_previousX[i], m_previousY[i]), Vector2(m_x[i], m_y[i]), alpha);
+        SDL_Rect particleRect = {
+            static_cast<int>(position.x - m_size[i]/2),
+            static_cast<int>(position.y - m_size[i]/2),
+            static_cast<int>(m_size[i]),
+            static_cast<int>(m_size[i])
+        };
+        queue.FillQuad(particleRect);
+    }
+}
\ No newline at end of file
@@ -1,25 +1,56 @@
 #include "Platform.h"
+#include "StoreColumns.h"
 
-Platform::Platform(float x, float y, float width, float height) 
-    : m_bounds(x, y, width, height) {
+PlatformStore::PlatformStore(LevelArena* arena) 
+    : m_x(arena), m_y(arena), m_width(arena), m_height(arena), m_keep(arena) {
 }
 
-void Platform::Render(SDL_Renderer* renderer) {
-    // Draw platform as a brown rectangle
-    SDL_SetRenderDrawColor(renderer, 139, 69, 19, 255);
-    SDL_Rect platformRect = {
-        static_cast<int>(m_bounds.x),
-        static_cast<int>(m_bounds.y),
-        static_cast<int>(m_bounds.width),
-        static_cast<int>(m_bounds.height)
-    };
-    SDL_RenderFillRect(renderer, &platformRect);
+void PlatformStore::Clear() {
+    ReleaseColumn(m_x);
+    ReleaseColumn(m_y);
+    ReleaseColumn(m_width);
+    ReleaseColumn(m_height);
+    ReleaseColumn(m_keep);
+}
+
+void PlatformStore::Reserve(size_t count) {
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_width.reserve(count);
+    m_height.reserve(count);
+    m_keep.reserve(count);
+}
+
+int PlatformStore::Add(float x, float y, float width, float height) {
+    m_x.push_back(x);
+    m_y.push_back(y);
+    m_width.push_back(width);
+    m_height.push_back(height);
+    return static_cast<int>(m_x.size()) - 1;
+}
+
+void PlatformStore::AddRange(size_t count, const float* x, const float* y, const float* width, const float* height) {
+    m_x.insert(m_x.end(), x, x + count);
+    m_y.insert(m_y.end(), y, y + count);
+    m_width.insert(m_width.end(), width, width + count);
+    m_height.insert(m_height.end(), height, height + count);
+}
+
+size_t PlatformStore::RemoveLeftOf(float x) {
+    size_t removed = MarkLeftOf(m_x, m_width, x, m_keep);
+    if (removed == 0) return 0;
     
-    // Draw platform border
-    SDL_SetRenderDrawColor(renderer, 101, 67, 33, 255);
-    SDL_RenderDrawRect(renderer, &platformRect);
+    CompactColumn(m_x, m_keep);
+    CompactColumn(m_y, m_keep);
+    CompactColumn(m_width, m_keep);
+    CompactColumn(m_height, m_keep);
+    return removed;
 }
 
-Rectangle Platform::GetBounds() const {
-    return m_bounds;
-} 
\ No newline at end of file
+void PlatformStore::SaveState(StateWriter& out) const {
+    WriteColumns(out, m_x, m_y, m_width, m_height);
+}
+
+bool PlatformStore::LoadState(StateReader& in) {
+    return ReadColumns(in, m_x, m_y, m_width, m_height) && AllWithin(MAX_STATE_COORDINATE, m_x, m_y, m_width, m_height);
+}
@@ -1,14 +1,40 @@
 #pragma once
-#include "Game.h"
-#include <SDL2/SDL.h>
+#include "Types.h"
+#include "LevelArena.h"
+#include <vector>
 
-class Platform {
+class RenderQueue;
+class StateWriter;
+class StateReader;
+
+// Static platforms stored as parallel arrays (structure of arrays)
+class PlatformStore {
 public:
-    Platform(float x, float y, float width, float height);
+    // Columns take their storage from arena when given (it must outlive the store), else from the heap
+    explicit PlatformStore(LevelArena* arena = nullptr);
+    
+    // Remove every entity and give the storage back, e.g. before the arena is reset
+    void Clear();
+    void Reserve(size_t count);
+    int Add(float x, float y, float width, float height);
+    // Bulk version of Add() for parallel arrays, e.g. the columns of a mapped LevelFile
+    void AddRange(size_t count, const float* x, const float* y, const float* width, const float* height);
+    // Remove the entities lying entirely left of x (scrolled out), keeping the order of the rest
+    size_t RemoveLeftOf(float x);
+    size_t Size() const { return m_x.size(); }
+    
+    // Write every column to a saved-state image, or replace them with the ones read from it
+    void SaveState(StateWriter& out) const;
+    bool LoadState(StateReader& in);
     
-    void Render(SDL_Renderer* renderer);
-    Rectangle GetBounds() const;
+    // Only platforms that intersect view are drawn
+    void Render(RenderQueue& queue, const Rectangle& view) const;
+    Rectangle GetBounds(int index) const { return Rectangle(m_x[index], m_y[index], m_width[index], m_height[index]); }
     
 private:
-    Rectangle m_bounds;
-}; 
\ No newline at end of file
+    ArenaVector<float> m_x;
+    ArenaVector<float> m_y;
+    ArenaVector<float> m_width;
+    ArenaVector<float> m_height;
+    ArenaVector<std::uint8_t> m_keep;  // RemoveLeftOf() scratch
+};
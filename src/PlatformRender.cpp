@@ -0,0 +1,26 @@
+#include "Platform.h"
+#include "RenderQueue.h"
+
+void PlatformStore::Render(RenderQueue& queue, const Rectangle& view) const {
+    queue.SetLayer(RenderLayer::PLATFORMS);
+    
+    for (size_t i = 0; i < m_x.size(); i++) {
+        if (!GetBounds(static_cast<int>(i)).Intersects(view)) continue;
+        
+        queue.BeginItem();
+        
+        // Draw platform as a brown rectangle
+        queue.SetDrawColor(139, 69, 19, 255);
+        SDL_Rect platformRect = {
+            static_cast<int>(m_x[i]),
+            static_cast<int>(m_y[i]),
+            static_cast<int>(m_width[i]),
+            static_cast<int>(m_height[i])
+        };
+        queue.FillRect(platformRect);
+        
+        // Draw platform border
+        queue.SetDrawColor(101, 67, 33, 255);
+        queue.DrawRect(platformRect);
+    }
+}
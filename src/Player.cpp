@@ -1,4 +1,5 @@
 #include "Player.h"
+#include "StateStream.h"
 #include <algorithm>
 #include <cmath>
 
@@ -8,12 +9,50 @@ const float Player::MAX_FALL_SPEED = 500.0f;
 const float Player::POWERED_UP_SCALE = 1.5f;
 
 Player::Player(float x, float y) 
-    : m_position(x, y), m_velocity(0, 0), m_width(30), m_height(30), 
+    : m_position(x, y), m_previousPosition(x, y), m_velocity(0, 0), m_width(30), m_height(30), 
       m_isOnGround(false), m_facingRight(true), m_isPoweredUp(false), m_powerUpTimer(0.0f),
       m_walkAnimTimer(0.0f), m_jumpAnimTimer(0.0f), m_invulnerabilityTimer(0.0f), m_isMoving(false),
       m_wasJumpKeyHeld(false), m_jumpBuffer(0.0f), m_coyoteTime(0.0f) {
 }
 
+void Player::SaveState(StateWriter& out) const {
+    out.Write(m_position);
+    out.Write(m_previousPosition);
+    out.Write(m_velocity);
+    out.Write(m_width);
+    out.Write(m_height);
+    out.WriteFlag(m_isOnGround);
+    out.WriteFlag(m_facingRight);
+    out.WriteFlag(m_isPoweredUp);
+    out.Write(m_powerUpTimer);
+    out.Write(m_walkAnimTimer);
+    out.Write(m_jumpAnimTimer);
+    out.Write(m_invulnerabilityTimer);
+    out.WriteFlag(m_isMoving);
+    out.WriteFlag(m_wasJumpKeyHeld);
+    out.Write(m_jumpBuffer);
+    out.Write(m_coyoteTime);
+}
+
+bool Player::LoadState(StateReader& in) {
+    return in.Read(m_position) && in.Read(m_previousPosition) && in.Read(m_velocity) && in.Read(m_width) &&
+           in.Read(m_height) && in.ReadFlag(m_isOnGround) && in.ReadFlag(m_facingRight) && 
+           in.ReadFlag(m_isPoweredUp) && in.Read(m_powerUpTimer) && in.Read(m_walkAnimTimer) && 
+           in.Read(m_jumpAnimTimer) && in.Read(m_invulnerabilityTimer) && in.ReadFlag(m_isMoving) && 
+           in.ReadFlag(m_wasJumpKeyHeld) && in.Read(m_jumpBuffer) && in.Read(m_coyoteTime) && IsValidState();
+}
+
+bool Player::IsValidState() const {
+    for (float value : {m_position.x, m_position.y, m_previousPosition.x, m_previousPosition.y, 
+                        m_velocity.x, m_velocity.y, m_width, m_height}) {
+        if (!(std::abs(value) <= MAX_STATE_COORDINATE)) return false;
+    }
+    for (float value : {m_powerUpTimer, m_walkAnimTimer, m_jumpAnimTimer, m_invulnerabilityTimer, m_jumpBuffer, m_coyoteTime}) {
+        if (!std::isfinite(value)) return false;
+    }
+    return true;
+}
+
 void Player::Update(float deltaTime) {
     UpdateAnimation(deltaTime);
     
@@ -52,134 +91,6 @@ void Player::Update(float deltaTime) {
     m_position = m_position + m_velocity * deltaTime;
 }
 
-void Player::Render(SDL_Renderer* renderer) {
-    if (m_isPoweredUp) {
-        RenderPoweredUp(renderer);
-    } else {
-        RenderNormal(renderer);
-    }
-}
-
-void Player::RenderNormal(SDL_Renderer* renderer) {
-    // Flashing effect when invulnerable
-    if (m_invulnerabilityTimer > 0) {
-        int flashRate = static_cast<int>(m_invulnerabilityTimer * 10) % 2;
-        if (flashRate == 0) return; // Skip rendering to create flashing effect
-    }
-    
-    // Draw player as a red rectangle with animation
-    float bounceOffset = 0;
-    if (m_jumpAnimTimer > 0) {
-        bounceOffset = sin(m_jumpAnimTimer * 10) * 3;
-    }
-    
-    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-    SDL_Rect playerRect = {
-        static_cast<int>(m_position.x),
-        static_cast<int>(m_position.y + bounceOffset),
-        static_cast<int>(m_width),
-        static_cast<int>(m_height)
-    };
-    SDL_RenderFillRect(renderer, &playerRect);
-    
-    // Draw walking animation (slight width variation)
-    if (m_isMoving && m_isOnGround) {
-        float walkOffset = sin(m_walkAnimTimer * 8) * 2;
-        SDL_Rect walkRect = {
-            static_cast<int>(m_position.x - walkOffset/2),
-            static_cast<int>(m_position.y + m_height - 5),
-            static_cast<int>(m_width + walkOffset),
-            5
-        };
-        SDL_SetRenderDrawColor(renderer, 200, 0, 0, 255);
-        SDL_RenderFillRect(renderer, &walkRect);
-    }
-    
-    // Draw eyes to show direction
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    int eyeSize = 4;
-    int eyeY = static_cast<int>(m_position.y + 8 + bounceOffset);
-    
-    if (m_facingRight) {
-        SDL_Rect rightEye = {static_cast<int>(m_position.x + 18), eyeY, eyeSize, eyeSize};
-        SDL_RenderFillRect(renderer, &rightEye);
-    } else {
-        SDL_Rect leftEye = {static_cast<int>(m_position.x + 8), eyeY, eyeSize, eyeSize};
-        SDL_RenderFillRect(renderer, &leftEye);
-    }
-    
-    // Draw pupils
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    int pupilSize = 2;
-    if (m_facingRight) {
-        SDL_Rect pupil = {static_cast<int>(m_position.x + 19), eyeY + 1, pupilSize, pupilSize};
-        SDL_RenderFillRect(renderer, &pupil);
-    } else {
-        SDL_Rect pupil = {static_cast<int>(m_position.x + 9), eyeY + 1, pupilSize, pupilSize};
-        SDL_RenderFillRect(renderer, &pupil);
-    }
-}
-
-void Player::RenderPoweredUp(SDL_Renderer* renderer) {
-    // Flashing effect when invulnerable
-    if (m_invulnerabilityTimer > 0) {
-        int flashRate = static_cast<int>(m_invulnerabilityTimer * 10) % 2;
-        if (flashRate == 0) return;
-    }
-    
-    float scaledWidth = m_width * POWERED_UP_SCALE;
-    float scaledHeight = m_height * POWERED_UP_SCALE;
-    float offsetX = (scaledWidth - m_width) * 0.5f;
-    float offsetY = scaledHeight - m_height;
-    
-    // Power-up glow effect
-    float pulse = (sin(m_powerUpTimer * 5) + 1.0f) * 0.5f;
-    
-    // Draw larger Mario with gradient effect
-    SDL_SetRenderDrawColor(renderer, 255, static_cast<Uint8>(100 + pulse * 100), 0, 255);
-    SDL_Rect powerRect = {
-        static_cast<int>(m_position.x - offsetX),
-        static_cast<int>(m_position.y - offsetY),
-        static_cast<int>(scaledWidth),
-        static_cast<int>(scaledHeight)
-    };
-    SDL_RenderFillRect(renderer, &powerRect);
-    
-    // Draw original size on top for layered effect
-    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 200);
-    SDL_Rect normalRect = {
-        static_cast<int>(m_position.x),
-        static_cast<int>(m_position.y),
-        static_cast<int>(m_width),
-        static_cast<int>(m_height)
-    };
-    SDL_RenderFillRect(renderer, &normalRect);
-    
-    // Enhanced eyes
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    int eyeSize = 6;
-    int eyeY = static_cast<int>(m_position.y + 8);
-    
-    if (m_facingRight) {
-        SDL_Rect rightEye = {static_cast<int>(m_position.x + 20), eyeY, eyeSize, eyeSize};
-        SDL_RenderFillRect(renderer, &rightEye);
-    } else {
-        SDL_Rect leftEye = {static_cast<int>(m_position.x + 4), eyeY, eyeSize, eyeSize};
-        SDL_RenderFillRect(renderer, &leftEye);
-    }
-    
-    // Power indicator "S" on chest
-    SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
-    int centerX = static_cast<int>(m_position.x + m_width/2);
-    int centerY = static_cast<int>(m_position.y + m_height/2);
-    SDL_Rect sTop = {centerX - 3, centerY - 4, 6, 2};
-    SDL_Rect sMiddle = {centerX - 3, centerY - 1, 6, 2};
-    SDL_Rect sBottom = {centerX - 3, centerY + 2, 6, 2};
-    SDL_RenderFillRect(renderer, &sTop);
-    SDL_RenderFillRect(renderer, &sMiddle);
-    SDL_RenderFillRect(renderer, &sBottom);
-}
-
 void Player::UpdateAnimation(float deltaTime) {
     // Update walk animation
     if (m_isMoving) {
@@ -194,51 +105,16 @@ void Player::UpdateAnimation(float deltaTime) {
     }
 }
 
-void Player::HandleInput(const bool* keystate, const bool* keysPressed) {
-    m_isMoving = false;
-    
-    // Horizontal movement
-    if (keystate[SDL_SCANCODE_LEFT] || keystate[SDL_SCANCODE_A]) {
-        float speed = m_isPoweredUp ? MOVE_SPEED * 1.3f : MOVE_SPEED;
-        m_velocity.x = -speed;
-        m_facingRight = false;
-        m_isMoving = true;
-    } else if (keystate[SDL_SCANCODE_RIGHT] || keystate[SDL_SCANCODE_D]) {
-        float speed = m_isPoweredUp ? MOVE_SPEED * 1.3f : MOVE_SPEED;
-        m_velocity.x = speed;
-        m_facingRight = true;
-        m_isMoving = true;
-    } else {
-        m_velocity.x = 0;
-    }
-    
-    // Jumping - use only continuous keystate for more reliable detection
-    bool jumpKeyCurrentlyHeld = (keystate[SDL_SCANCODE_UP] || keystate[SDL_SCANCODE_W] || keystate[SDL_SCANCODE_SPACE]);
-    
-    // Jump when key is newly pressed (wasn't held last frame, but is held now)
-    bool shouldJump = jumpKeyCurrentlyHeld && !m_wasJumpKeyHeld && m_isOnGround;
-    
-    if (shouldJump) {
-        float jumpForce = m_isPoweredUp ? JUMP_FORCE * 1.2f : JUMP_FORCE;
-        m_velocity.y = jumpForce;
-        m_isOnGround = false;
-        PlayJumpAnimation();
-    }
-    
-    // Update jump key state for next frame
-    m_wasJumpKeyHeld = jumpKeyCurrentlyHeld;
-}
-
-void Player::HandleInputSimple(const Uint8* keystate) {
+void Player::HandleInput(const PlayerInput& input) {
     m_isMoving = false;
     
     // Horizontal movement
-    if (keystate[SDL_SCANCODE_LEFT] || keystate[SDL_SCANCODE_A]) {
+    if (input.left) {
         float speed = m_isPoweredUp ? MOVE_SPEED * 1.3f : MOVE_SPEED;
         m_velocity.x = -speed;
         m_facingRight = false;
         m_isMoving = true;
-    } else if (keystate[SDL_SCANCODE_RIGHT] || keystate[SDL_SCANCODE_D]) {
+    } else if (input.right) {
         float speed = m_isPoweredUp ? MOVE_SPEED * 1.3f : MOVE_SPEED;
         m_velocity.x = speed;
         m_facingRight = true;
@@ -248,7 +124,7 @@ void Player::HandleInputSimple(const Uint8* keystate) {
     }
     
     // Jumping with buffer system - much more forgiving
-    bool jumpKeyHeld = (keystate[SDL_SCANCODE_UP] || keystate[SDL_SCANCODE_W] || keystate[SDL_SCANCODE_SPACE]);
+    bool jumpKeyHeld = input.jump;
     
     // Set jump buffer when any jump key is pressed
     if (jumpKeyHeld && !m_wasJumpKeyHeld) {
@@ -269,30 +145,19 @@ void Player::HandleInputSimple(const Uint8* keystate) {
     m_wasJumpKeyHeld = jumpKeyHeld;
 }
 
-Rectangle Player::GetBounds() const {
+Rectangle Player::GetBoundsAt(const Vector2& position) const {
     if (m_isPoweredUp) {
         float scaledWidth = m_width * POWERED_UP_SCALE;
         float scaledHeight = m_height * POWERED_UP_SCALE;
         float offsetX = (scaledWidth - m_width) * 0.5f;
         float offsetY = scaledHeight - m_height;
-        return Rectangle(m_position.x - offsetX, m_position.y - offsetY, scaledWidth, scaledHeight);
+        return Rectangle(position.x - offsetX, position.y - offsetY, scaledWidth, scaledHeight);
     }
-    return Rectangle(m_position.x, m_position.y, m_width, m_height);
+    return Rectangle(position.x, position.y, m_width, m_height);
 }
 
-void Player::ResolveCollision(const Rectangle& platform) {
-    Rectangle playerBounds = GetBounds();
-    
-    // Calculate overlap
-    float overlapLeft = (playerBounds.x + playerBounds.width) - platform.x;
-    float overlapRight = (platform.x + platform.width) - playerBounds.x;
-    float overlapTop = (playerBounds.y + playerBounds.height) - platform.y;
-    float overlapBottom = (platform.y + platform.height) - playerBounds.y;
-    
-    // Find minimum overlap
-    float minOverlap = std::min({overlapLeft, overlapRight, overlapTop, overlapBottom});
-    
-    if (minOverlap == overlapTop && m_velocity.y >= 0) {
+void Player::ResolveCollision(const Rectangle& platform, const Vector2& normal) {
+    if (normal.y < 0) {
         // Landing on top of platform
         if (m_isPoweredUp) {
             m_position.y = platform.y - (m_height * POWERED_UP_SCALE);
@@ -301,11 +166,11 @@ void Player::ResolveCollision(const Rectangle& platform) {
         }
         m_velocity.y = 0;
         m_isOnGround = true;
-    } else if (minOverlap == overlapBottom && m_velocity.y < 0) {
+    } else if (normal.y > 0) {
         // Hitting platform from below
         m_position.y = platform.y + platform.height;
         m_velocity.y = 0;
-    } else if (minOverlap == overlapLeft && m_velocity.x > 0) {
+    } else if (normal.x < 0) {
         // Hitting platform from left
         if (m_isPoweredUp) {
             float offsetX = (m_width * POWERED_UP_SCALE - m_width) * 0.5f;
@@ -314,7 +179,7 @@ void Player::ResolveCollision(const Rectangle& platform) {
             m_position.x = platform.x - m_width;
         }
         m_velocity.x = 0;
-    } else if (minOverlap == overlapRight && m_velocity.x < 0) {
+    } else if (normal.x > 0) {
         // Hitting platform from right
         if (m_isPoweredUp) {
             float offsetX = (m_width * POWERED_UP_SCALE - m_width) * 0.5f;
@@ -324,4 +189,30 @@ void Player::ResolveCollision(const Rectangle& platform) {
         }
         m_velocity.x = 0;
     }
-} 
\ No newline at end of file
+}
+
+Vector2 Player::ResolveCollision(const Rectangle& platform) {
+    Rectangle playerBounds = GetBounds();
+    
+    // Calculate overlap
+    float overlapLeft = (playerBounds.x + playerBounds.width) - platform.x;
+    float overlapRight = (platform.x + platform.width) - playerBounds.x;
+    float overlapTop = (playerBounds.y + playerBounds.height) - platform.y;
+    float overlapBottom = (platform.y + platform.height) - playerBounds.y;
+    
+    // Find minimum overlap
+    float minOverlap = std::min({overlapLeft, overlapRight, overlapTop, overlapBottom});
+    
+    Vector2 normal;
+    if (minOverlap == overlapTop && m_velocity.y >= 0) {
+        normal = Vector2(0, -1);
+    } else if (minOverlap == overlapBottom && m_velocity.y < 0) {
+        normal = Vector2(0, 1);
+    } else if (minOverlap == overlapLeft && m_velocity.x > 0) {
+        normal = Vector2(-1, 0);
+    } else if (minOverlap == overlapRight && m_velocity.x < 0) {
+        normal = Vector2(1, 0);
+    }
+    ResolveCollision(platform, normal);
+    return normal;
+}
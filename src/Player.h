@@ -1,24 +1,47 @@
 #pragma once
-#include "Game.h"
-#include <SDL2/SDL.h>
+#include "Types.h"
+
+class RenderQueue;
+class SpriteAtlas;
+class StateWriter;
+class StateReader;
+
+// Action keys sampled once per simulation tick
+struct PlayerInput {
+    bool left = false;
+    bool right = false;
+    bool jump = false;        // Jump key held
+    bool jumpPressed = false; // Jump key went down since the previous tick
+};
 
 class Player {
 public:
     Player(float x, float y);
     
     void Update(float deltaTime);
-    void Render(SDL_Renderer* renderer);
-    void HandleInput(const bool* keystate, const bool* keysPressed);
-    void HandleInputSimple(const Uint8* keystate);
+    void Render(RenderQueue& queue, const SpriteAtlas& sprites, float alpha = 1.0f) const;
+    
+    // Register the standing, walking and powered-up frames with the sprite atlas
+    static void BakeSprites(SpriteAtlas& atlas);
+    void HandleInput(const PlayerInput& input);
     
-    Rectangle GetBounds() const;
+    Rectangle GetBounds() const { return GetBoundsAt(m_position); }
+    // Bounds at the start of the tick, where this tick's motion began
+    Rectangle GetPreviousBounds() const { return GetBoundsAt(m_previousPosition); }
     Vector2 GetPosition() const { return m_position; }
     void SetPosition(const Vector2& pos) { m_position = pos; }
     
+    // Remember the current position as the start of the next interpolation span
+    void StorePreviousState() { m_previousPosition = m_position; }
+    
     bool IsOnGround() const { return m_isOnGround; }
     void SetOnGround(bool onGround) { m_isOnGround = onGround; }
     
-    void ResolveCollision(const Rectangle& platform);
+    // Stop against the side of platform that was run into (a SweepHit normal)
+    void ResolveCollision(const Rectangle& platform, const Vector2& normal);
+    // Push out of an overlapping platform along the shallowest axis; returns
+    // the side pushed out of, or (0, 0) when the player was moving away
+    Vector2 ResolveCollision(const Rectangle& platform);
     
     // Power-up system
     void SetPoweredUp(bool powered) { m_isPoweredUp = powered; m_powerUpTimer = powered ? 10.0f : 0.0f; }
@@ -29,12 +52,23 @@ public:
     void SetInvulnerable(float time) { m_invulnerabilityTimer = time; }
     bool IsInvulnerable() const { return m_invulnerabilityTimer > 0; }
     
+    // Write the player to a saved-state image field by field, or read it back
+    // (failing on flags that are not 0 or 1 and on out-of-range values)
+    void SaveState(StateWriter& out) const;
+    bool LoadState(StateReader& in);
+    
 private:
-    void RenderNormal(SDL_Renderer* renderer);
-    void RenderPoweredUp(SDL_Renderer* renderer);
+    Rectangle GetBoundsAt(const Vector2& position) const;
+    // Positions and sizes within MAX_STATE_COORDINATE and timers finite, as play leaves them
+    bool IsValidState() const;
+    
+    // Draw one pose from primitives (used to bake the sprite frames)
+    void RenderNormal(RenderQueue& queue, const Vector2& position) const;
+    void RenderPoweredUp(RenderQueue& queue, const Vector2& position) const;
     void UpdateAnimation(float deltaTime);
     
     Vector2 m_position;
+    Vector2 m_previousPosition;
     Vector2 m_velocity;
     float m_width;
     float m_height;
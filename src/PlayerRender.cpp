@@ -0,0 +1,187 @@
+#include "Player.h"
+#include "RenderQueue.h"
+#include "SpriteAtlas.h"
+#include "FastTrig.h"
+#include <cmath>
+
+static const int PLAYER_WALK_FRAMES = 16;   // Baked steps of the walk cycle (plus one standing frame)
+static const int PLAYER_PULSE_FRAMES = 8;   // Baked glow levels while powered up
+
+void Player::BakeSprites(SpriteAtlas& atlas) {
+    // Pose the visuals on a stand-in player so the drawing code below is shared
+    const Player prototype(0, 0);
+    
+    // Room for the powered-up body, which grows upwards and to both sides
+    int marginX = static_cast<int>((prototype.m_width * POWERED_UP_SCALE - prototype.m_width) * 0.5f) + 2;
+    int marginTop = static_cast<int>(prototype.m_height * POWERED_UP_SCALE - prototype.m_height) + 2;
+    int width = static_cast<int>(prototype.m_width) + 2 * marginX;
+    int height = static_cast<int>(prototype.m_height) + marginTop + 2;
+    
+    for (int direction = 0; direction < 2; direction++) {
+        bool facingRight = direction == 0;
+        
+        atlas.AddSheet(facingRight ? SpriteSheet::PLAYER_RIGHT : SpriteSheet::PLAYER_LEFT, 1 + PLAYER_WALK_FRAMES,
+            width, height, marginX, marginTop,
+            [prototype, facingRight](RenderQueue& queue, int frame, int x, int y) {
+                Player pose = prototype;
+                pose.m_facingRight = facingRight;
+                pose.m_isOnGround = true;
+                pose.m_isMoving = frame > 0;
+                pose.m_walkAnimTimer = (frame - 1) * 2.0f * 3.14159265f / PLAYER_WALK_FRAMES / 8.0f;
+                pose.RenderNormal(queue, Vector2(static_cast<float>(x), static_cast<float>(y)));
+            });
+        
+        atlas.AddSheet(facingRight ? SpriteSheet::PLAYER_POWERED_RIGHT : SpriteSheet::PLAYER_POWERED_LEFT, PLAYER_PULSE_FRAMES,
+            width, height, marginX, marginTop,
+            [prototype, facingRight](RenderQueue& queue, int frame, int x, int y) {
+                Player pose = prototype;
+                pose.m_facingRight = facingRight;
+                float pulse = static_cast<float>(frame) / (PLAYER_PULSE_FRAMES - 1);
+                pose.m_powerUpTimer = asin(pulse * 2.0f - 1.0f) / 5.0f;
+                pose.RenderPoweredUp(queue, Vector2(static_cast<float>(x), static_cast<float>(y)));
+            });
+    }
+}
+
+void Player::Render(RenderQueue& queue, const SpriteAtlas& sprites, float alpha) const {
+    // Flashing effect when invulnerable
+    if (m_invulnerabilityTimer > 0) {
+        int flashRate = static_cast<int>(m_invulnerabilityTimer * 10) % 2;
+        if (flashRate == 0) return; // Skip rendering to create flashing effect
+    }
+    
+    queue.SetLayer(RenderLayer::PLAYER);
+    queue.BeginItem();
+    
+    Vector2 position = Lerp(m_previousPosition, m_position, alpha);
+    int x = static_cast<int>(position.x);
+    
+    if (m_isPoweredUp) {
+        // Power-up glow effect
+        float pulse = (FastSin(m_powerUpTimer * 5) + 1.0f) * 0.5f;
+        int frame = static_cast<int>(pulse * (PLAYER_PULSE_FRAMES - 1) + 0.5f);
+        SpriteSheet sheet = m_facingRight ? SpriteSheet::PLAYER_POWERED_RIGHT : SpriteSheet::PLAYER_POWERED_LEFT;
+        sprites.Draw(queue, sheet, frame, x, static_cast<int>(position.y));
+    } else {
+        // Bounce the whole sprite while the jump animation plays
+        float bounceOffset = 0;
+        if (m_jumpAnimTimer > 0) {
+            bounceOffset = FastSin(m_jumpAnimTimer * 10) * 3;
+        }
+        
+        int frame = 0; // Standing
+        if (m_isMoving && m_isOnGround) {
+            frame = 1 + SpriteAtlas::PhaseToFrame(m_walkAnimTimer * 8, PLAYER_WALK_FRAMES);
+        }
+        SpriteSheet sheet = m_facingRight ? SpriteSheet::PLAYER_RIGHT : SpriteSheet::PLAYER_LEFT;
+        sprites.Draw(queue, sheet, frame, x, static_cast<int>(position.y + bounceOffset));
+    }
+}
+
+void Player::RenderNormal(RenderQueue& queue, const Vector2& position) const {
+    // Draw player as a red rectangle with animation
+    float bounceOffset = 0;
+    if (m_jumpAnimTimer > 0) {
+        bounceOffset = sin(m_jumpAnimTimer * 10) * 3;
+    }
+    
+    queue.SetDrawColor(255, 0, 0, 255);
+    SDL_Rect playerRect = {
+        static_cast<int>(position.x),
+        static_cast<int>(position.y + bounceOffset),
+        static_cast<int>(m_width),
+        static_cast<int>(m_height)
+    };
+    queue.FillRect(playerRect);
+    
+    // Draw walking animation (slight width variation)
+    if (m_isMoving && m_isOnGround) {
+        float walkOffset = sin(m_walkAnimTimer * 8) * 2;
+        SDL_Rect walkRect = {
+            static_cast<int>(position.x - walkOffset/2),
+            static_cast<int>(position.y + m_height - 5),
+            static_cast<int>(m_width + walkOffset),
+            5
+        };
+        queue.SetDrawColor(200, 0, 0, 255);
+        queue.FillRect(walkRect);
+    }
+    
+    // Draw eyes to show direction
+    queue.SetDrawColor(255, 255, 255, 255);
+    int eyeSize = 4;
+    int eyeY = static_cast<int>(position.y + 8 + bounceOffset);
+    
+    if (m_facingRight) {
+        SDL_Rect rightEye = {static_cast<int>(position.x + 18), eyeY, eyeSize, eyeSize};
+        queue.FillRect(rightEye);
+    } else {
+        SDL_Rect leftEye = {static_cast<int>(position.x + 8), eyeY, eyeSize, eyeSize};
+        queue.FillRect(leftEye);
+    }
+    
+    // Draw pupils
+    queue.SetDrawColor(0, 0, 0, 255);
+    int pupilSize = 2;
+    if (m_facingRight) {
+        SDL_Rect pupil = {static_cast<int>(position.x + 19), eyeY + 1, pupilSize, pupilSize};
+        queue.FillRect(pupil);
+    } else {
+        SDL_Rect pupil = {static_cast<int>(position.x + 9), eyeY + 1, pupilSize, pupilSize};
+        queue.FillRect(pupil);
+    }
+}
+
+void Player::RenderPoweredUp(RenderQueue& queue, const Vector2& position) const {
+    float scaledWidth = m_width * POWERED_UP_SCALE;
+    float scaledHeight = m_height * POWERED_UP_SCALE;
+    float offsetX = (scaledWidth - m_width) * 0.5f;
+    float offsetY = scaledHeight - m_height;
+    
+    // Power-up glow effect
+    float pulse = (sin(m_powerUpTimer * 5) + 1.0f) * 0.5f;
+    
+    // Draw larger Mario with gradient effect
+    queue.SetDrawColor(255, static_cast<Uint8>(100 + pulse * 100), 0, 255);
+    SDL_Rect powerRect = {
+        static_cast<int>(position.x - offsetX),
+        static_cast<int>(position.y - offsetY),
+        static_cast<int>(scaledWidth),
+        static_cast<int>(scaledHeight)
+    };
+    queue.FillRect(powerRect);
+    
+    // Draw original size on top for layered effect
+    queue.SetDrawColor(255, 0, 0, 200);
+    SDL_Rect normalRect = {
+        static_cast<int>(position.x),
+        static_cast<int>(position.y),
+        static_cast<int>(m_width),
+        static_cast<int>(m_height)
+    };
+    queue.FillRect(normalRect);
+    
+    // Enhanced eyes
+    queue.SetDrawColor(255, 255, 255, 255);
+    int eyeSize = 6;
+    int eyeY = static_cast<int>(position.y + 8);
+    
+    if (m_facingRight) {
+        SDL_Rect rightEye = {static_cast<int>(position.x + 20), eyeY, eyeSize, eyeSize};
+        queue.FillRect(rightEye);
+    } else {
+        SDL_Rect leftEye = {static_cast<int>(position.x + 4), eyeY, eyeSize, eyeSize};
+        queue.FillRect(leftEye);
+    }
+    
+    // Power indicator "S" on chest
+    queue.SetDrawColor(255, 255, 0, 255);
+    int centerX = static_cast<int>(position.x + m_width/2);
+    int centerY = static_cast<int>(position.y + m_height/2);
+    SDL_Rect sTop = {centerX - 3, centerY - 4, 6, 2};
+    SDL_Rect sMiddle = {centerX - 3, centerY - 1, 6, 2};
+    SDL_Rect sBottom = {centerX - 3, centerY + 2, 6, 2};
+    queue.FillRect(sTop);
+    queue.FillRect(sMiddle);
+    queue.FillRect(sBottom);
+}
@@ -1,106 +1,109 @@
 #include "PowerUp.h"
-#include <cmath>
+#include "StoreColumns.h"
+#include "FastTrig.h"
 
-const float PowerUp::ANIMATION_SPEED = 2.0f;
+const float PowerUpStore::WIDTH = 25.0f;
+const float PowerUpStore::HEIGHT = 25.0f;
+const float PowerUpStore::ANIMATION_SPEED = 2.0f;
+const float PowerUpStore::PULSE_FREQUENCY = 3.0f;
+const float PowerUpStore::PULSE_AMPLITUDE = 0.2f;  // Scale swings between 80% and 120%
 
-PowerUp::PowerUp(float x, float y, PowerUpType type) 
-    : m_position(x, y), m_width(25), m_height(25), m_isCollected(false), 
-      m_type(type), m_animationTimer(0.0f) {
-    
-    // Set color based on type
-    switch (m_type) {
+PowerUpStore::PowerUpStore(LevelArena* arena) 
+    : m_x(arena), m_y(arena), m_isCollected(arena), m_type(arena), m_animationTimer(arena), m_pulseScale(arena), m_keep(arena) {
+}
+
+void PowerUpStore::Clear() {
+    ReleaseColumn(m_x);
+    ReleaseColumn(m_y);
+    ReleaseColumn(m_isCollected);
+    ReleaseColumn(m_type);
+    ReleaseColumn(m_animationTimer);
+    ReleaseColumn(m_pulseScale);
+    ReleaseColumn(m_keep);
+}
+
+void PowerUpStore::Reserve(size_t count) {
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_isCollected.reserve(count);
+    m_type.reserve(count);
+    m_animationTimer.reserve(count);
+    m_pulseScale.reserve(count);
+    m_keep.reserve(count);
+}
+
+Color PowerUpStore::GetColor(PowerUpType type) {
+    switch (type) {
         case PowerUpType::SUPER_MARIO:
-            m_color = Color(255, 0, 0); // Red
-            break;
+            return Color(255, 0, 0); // Red
         case PowerUpType::SPEED_BOOST:
-            m_color = Color(0, 255, 0); // Green
-            break;
+            return Color(0, 255, 0); // Green
         case PowerUpType::EXTRA_LIFE:
-            m_color = Color(255, 0, 255); // Magenta
-            break;
+            return Color(255, 0, 255); // Magenta
     }
+    return Color();
 }
 
-void PowerUp::Update(float deltaTime) {
-    if (m_isCollected) return;
-    
-    m_animationTimer += deltaTime * ANIMATION_SPEED;
+int PowerUpStore::Add(float x, float y, PowerUpType type) {
+    m_x.push_back(x);
+    m_y.push_back(y);
+    m_isCollected.push_back(0);
+    m_type.push_back(type);
+    m_animationTimer.push_back(0.0f);
+    m_pulseScale.push_back(1.0f);
+    return static_cast<int>(m_x.size()) - 1;
 }
 
-void PowerUp::Render(SDL_Renderer* renderer) {
-    if (m_isCollected) return;
-    
-    // Pulsing effect
-    float pulse = (sin(m_animationTimer * 3.0f) + 1.0f) * 0.5f;
-    float scale = 0.8f + pulse * 0.4f;
-    
-    float scaledWidth = m_width * scale;
-    float scaledHeight = m_height * scale;
-    float offsetX = (m_width - scaledWidth) * 0.5f;
-    float offsetY = (m_height - scaledHeight) * 0.5f;
-    
-    // Draw power-up based on type
-    SDL_SetRenderDrawColor(renderer, m_color.r, m_color.g, m_color.b, m_color.a);
-    
-    SDL_Rect powerUpRect = {
-        static_cast<int>(m_position.x + offsetX),
-        static_cast<int>(m_position.y + offsetY),
-        static_cast<int>(scaledWidth),
-        static_cast<int>(scaledHeight)
-    };
-    SDL_RenderFillRect(renderer, &powerUpRect);
+void PowerUpStore::AddRange(size_t count, const float* x, const float* y, const PowerUpType* type) {
+    m_x.insert(m_x.end(), x, x + count);
+    m_y.insert(m_y.end(), y, y + count);
+    m_isCollected.insert(m_isCollected.end(), count, 0);
+    m_type.insert(m_type.end(), type, type + count);
+    m_animationTimer.insert(m_animationTimer.end(), count, 0.0f);
+    m_pulseScale.insert(m_pulseScale.end(), count, 1.0f);
+}
+
+size_t PowerUpStore::RemoveLeftOf(float x) {
+    size_t removed = MarkLeftOf(m_x, WIDTH, x, m_keep);
+    if (removed == 0) return 0;
     
-    // Add type-specific visual elements
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    int centerX = static_cast<int>(m_position.x + m_width/2);
-    int centerY = static_cast<int>(m_position.y + m_height/2);
+    CompactColumn(m_x, m_keep);
+    CompactColumn(m_y, m_keep);
+    CompactColumn(m_isCollected, m_keep);
+    CompactColumn(m_type, m_keep);
+    CompactColumn(m_animationTimer, m_keep);
+    CompactColumn(m_pulseScale, m_keep);
+    return removed;
+}
+
+void PowerUpStore::SaveState(StateWriter& out) const {
+    WriteColumns(out, m_x, m_y, m_isCollected, m_type, m_animationTimer, m_pulseScale);
+}
+
+bool PowerUpStore::LoadState(StateReader& in) {
+    if (!ReadColumns(in, m_x, m_y, m_isCollected, m_type, m_animationTimer, m_pulseScale) ||
+        !AllWithin(MAX_STATE_COORDINATE, m_x, m_y, m_pulseScale) || !AllFinite(m_animationTimer)) {
+        return false;
+    }
     
-    switch (m_type) {
-        case PowerUpType::SUPER_MARIO:
-        {
-            // Draw "S" for Super
-            SDL_Rect sTop = {centerX - 4, centerY - 6, 8, 2};
-            SDL_Rect sMiddle = {centerX - 4, centerY - 1, 8, 2};
-            SDL_Rect sBottom = {centerX - 4, centerY + 4, 8, 2};
-            SDL_RenderFillRect(renderer, &sTop);
-            SDL_RenderFillRect(renderer, &sMiddle);
-            SDL_RenderFillRect(renderer, &sBottom);
-            break;
-        }
-            
-        case PowerUpType::SPEED_BOOST:
-        {
-            // Draw lightning bolt
-            SDL_RenderDrawLine(renderer, centerX - 3, centerY - 6, centerX + 1, centerY);
-            SDL_RenderDrawLine(renderer, centerX - 1, centerY, centerX + 3, centerY + 6);
-            SDL_RenderDrawLine(renderer, centerX - 2, centerY - 3, centerX + 2, centerY - 3);
-            SDL_RenderDrawLine(renderer, centerX - 2, centerY + 3, centerX + 2, centerY + 3);
-            break;
-        }
-            
-        case PowerUpType::EXTRA_LIFE:
-        {
-            // Draw heart shape
-            for (int y = -4; y <= 2; y++) {
-                for (int x = -5; x <= 5; x++) {
-                    // Simple heart approximation
-                    if ((x*x + (y+2)*(y+2) <= 9 && y <= 0) || 
-                        ((x-2)*(x-2) + (y-1)*(y-1) <= 4) || 
-                        ((x+2)*(x+2) + (y-1)*(y-1) <= 4)) {
-                        SDL_RenderDrawPoint(renderer, centerX + x, centerY + y);
-                    }
-                }
-            }
-            break;
+    // Collecting a power-up switches on its type, so reject values outside the enum
+    for (PowerUpType type : m_type) {
+        if (static_cast<std::uint32_t>(type) > static_cast<std::uint32_t>(PowerUpType::EXTRA_LIFE)) {
+            return false;
         }
     }
-    
-    // Draw border
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-    SDL_RenderDrawRect(renderer, &powerUpRect);
+    return true;
 }
 
-Rectangle PowerUp::GetBounds() const {
-    if (m_isCollected) return Rectangle(0, 0, 0, 0);
-    return Rectangle(m_position.x, m_position.y, m_width, m_height);
-} 
\ No newline at end of file
+void PowerUpStore::Update(float deltaTime) {
+    const size_t count = m_x.size();
+    for (size_t i = 0; i < count; i++) {
+        m_animationTimer[i] += deltaTime * ANIMATION_SPEED;
+    }
+    EvaluateWave(m_animationTimer.data(), count, PULSE_FREQUENCY, PULSE_AMPLITUDE, 1.0f, m_pulseScale.data());
+}
+
+Rectangle PowerUpStore::GetBounds(int index) const {
+    if (m_isCollected[index]) return Rectangle(0, 0, 0, 0);
+    return Rectangle(m_x[index], m_y[index], WIDTH, HEIGHT);
+}
@@ -1,6 +1,13 @@
 #pragma once
-#include "Game.h"
-#include <SDL2/SDL.h>
+#include "Types.h"
+#include "LevelArena.h"
+#include <vector>
+#include <cstdint>
+
+class RenderQueue;
+class StateWriter;
+class StateReader;
+class SpriteAtlas;
 
 enum class PowerUpType {
     SUPER_MARIO,
@@ -8,26 +15,54 @@ enum class PowerUpType {
     EXTRA_LIFE
 };
 
-class PowerUp {
+// Power-ups stored as parallel arrays (structure of arrays)
+class PowerUpStore {
 public:
-    PowerUp(float x, float y, PowerUpType type);
+    // Columns take their storage from arena when given (it must outlive the store), else from the heap
+    explicit PowerUpStore(LevelArena* arena = nullptr);
+    
+    // Remove every entity and give the storage back, e.g. before the arena is reset
+    void Clear();
+    void Reserve(size_t count);
+    int Add(float x, float y, PowerUpType type);
+    void AddRange(size_t count, const float* x, const float* y, const PowerUpType* type);
+    size_t RemoveLeftOf(float x);
+    size_t Size() const { return m_x.size(); }
     
+    // Write every column to a saved-state image, or replace them with the ones read from it
+    void SaveState(StateWriter& out) const;
+    bool LoadState(StateReader& in);
+    
+    // Advance the pulse animation of every power-up in one vectorized pass
     void Update(float deltaTime);
-    void Render(SDL_Renderer* renderer);
-    Rectangle GetBounds() const;
+    // Only power-ups that intersect view are drawn
+    void Render(RenderQueue& queue, const SpriteAtlas& sprites, const Rectangle& view) const;
+    
+    // Register one sprite frame per power-up type with the atlas
+    static void BakeSprites(SpriteAtlas& atlas);
+    static Color GetColor(PowerUpType type);
+    Rectangle GetBounds(int index) const;
     
-    bool IsCollected() const { return m_isCollected; }
-    void Collect() { m_isCollected = true; }
-    PowerUpType GetType() const { return m_type; }
+    bool IsCollected(int index) const { return m_isCollected[index] != 0; }
+    void Collect(int index) { m_isCollected[index] = 1; }
+    PowerUpType GetType(int index) const { return m_type[index]; }
+    
+    static const float WIDTH;
+    static const float HEIGHT;
     
 private:
-    Vector2 m_position;
-    float m_width;
-    float m_height;
-    bool m_isCollected;
-    PowerUpType m_type;
-    float m_animationTimer;
-    Color m_color;
+    // Hot data
+    ArenaVector<float> m_x;
+    ArenaVector<float> m_y;
+    ArenaVector<std::uint8_t> m_isCollected;
+    
+    // Cold data
+    ArenaVector<PowerUpType> m_type;
+    ArenaVector<float> m_animationTimer;
+    ArenaVector<float> m_pulseScale;  // Sprite scale, written by Update()
+    ArenaVector<std::uint8_t> m_keep;  // RemoveLeftOf() scratch
     
     static const float ANIMATION_SPEED;
-}; 
\ No newline at end of file
+    static const float PULSE_FREQUENCY;
+    static const float PULSE_AMPLITUDE;
+};
@@ -0,0 +1,98 @@
+#include "PowerUp.h"
+#include "RenderQueue.h"
+#include "SpriteAtlas.h"
+
+// Coloured box with the type's symbol and a white border
+static void DrawPowerUp(RenderQueue& queue, PowerUpType type, const SDL_Rect& rect) {
+    // Draw power-up based on type
+    Color color = PowerUpStore::GetColor(type);
+    queue.SetDrawColor(color.r, color.g, color.b, color.a);
+    queue.FillRect(rect);
+    
+    // Add type-specific visual elements
+    queue.SetDrawColor(255, 255, 255, 255);
+    int centerX = rect.x + rect.w/2;
+    int centerY = rect.y + rect.h/2;
+    
+    switch (type) {
+        case PowerUpType::SUPER_MARIO:
+        {
+            // Draw "S" for Super
+            SDL_Rect sTop = {centerX - 4, centerY - 6, 8, 2};
+            SDL_Rect sMiddle = {centerX - 4, centerY - 1, 8, 2};
+            SDL_Rect sBottom = {centerX - 4, centerY + 4, 8, 2};
+            queue.FillRect(sTop);
+            queue.FillRect(sMiddle);
+            queue.FillRect(sBottom);
+            break;
+        }
+            
+        case PowerUpType::SPEED_BOOST:
+        {
+            // Draw lightning bolt
+            queue.DrawLine(centerX - 3, centerY - 6, centerX + 1, centerY);
+            queue.DrawLine(centerX - 1, centerY, centerX + 3, centerY + 6);
+            queue.DrawLine(centerX - 2, centerY - 3, centerX + 2, centerY - 3);
+            queue.DrawLine(centerX - 2, centerY + 3, centerX + 2, centerY + 3);
+            break;
+        }
+            
+        case PowerUpType::EXTRA_LIFE:
+        {
+            // Draw heart shape
+            for (int y = -4; y <= 2; y++) {
+                for (int x = -5; x <= 5; x++) {
+                    // Simple heart approximation
+                    if ((x*x + (y+2)*(y+2) <= 9 && y <= 0) || 
+                        ((x-2)*(x-2) + (y-1)*(y-1) <= 4) || 
+                        ((x+2)*(x+2) + (y-1)*(y-1) <= 4)) {
+                        queue.DrawPoint(centerX + x, centerY + y);
+                    }
+                }
+            }
+            break;
+        }
+    }
+    
+    // Draw border
+    queue.SetDrawColor(255, 255, 255, 255);
+    queue.DrawRect(rect);
+}
+
+void PowerUpStore::BakeSprites(SpriteAtlas& atlas) {
+    // One frame per type at full size; the pulse scales the whole sprite
+    int width = static_cast<int>(WIDTH);
+    int height = static_cast<int>(HEIGHT);
+    atlas.AddSheet(SpriteSheet::POWER_UP, 3, width, height, 0, 0,
+        [width, height](RenderQueue& queue, int frame, int x, int y) {
+            DrawPowerUp(queue, static_cast<PowerUpType>(frame), {x, y, width, height});
+        });
+}
+
+void PowerUpStore::Render(RenderQueue& queue, const SpriteAtlas& sprites, const Rectangle& view) const {
+    queue.SetLayer(RenderLayer::POWER_UPS);
+    
+    for (size_t i = 0; i < m_x.size(); i++) {
+        // The pulse grows the sprite to at most 120% of the bounds
+        if (m_isCollected[i] || !GetBounds(static_cast<int>(i)).Expand(WIDTH * 0.1f).Intersects(view)) continue;
+        
+        queue.BeginItem();
+        
+        // Pulsing effect
+        float scale = m_pulseScale[i];
+        
+        float scaledWidth = WIDTH * scale;
+        float scaledHeight = HEIGHT * scale;
+        float offsetX = (WIDTH - scaledWidth) * 0.5f;
+        float offsetY = (HEIGHT - scaledHeight) * 0.5f;
+        
+        SDL_Rect powerUpRect = {
+            static_cast<int>(m_x[i] + offsetX),
+            static_cast<int>(m_y[i] + offsetY),
+            static_cast<int>(scaledWidth),
+            static_cast<int>(scaledHeight)
+        };
+        sprites.DrawScaled(queue, SpriteSheet::POWER_UP, static_cast<int>(m_type[i]), powerUpRect,
+                           static_cast<int>(WIDTH), static_cast<int>(HEIGHT));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+Profiler::Profiler(size_t historyFrames) 
+    : m_historyFrames(std::max<size_t>(historyFrames, 1)), m_historySize(0), m_nextFrame(0), m_frameNumber(0) {
+    m_history.resize(m_historyFrames * ZONE_COUNT, 0.0);
+    m_frameNumbers.resize(m_historyFrames, 0);
+    m_scratch.reserve(m_historyFrames);
+    std::fill(m_current, m_current + ZONE_COUNT, 0.0);
+    m_frameStart = Clock::now();
+}
+
+void Profiler::BeginFrame() {
+    std::fill(m_current, m_current + ZONE_COUNT, 0.0);
+    m_frameStart = Clock::now();
+}
+
+void Profiler::EndFrame() {
+    std::chrono::duration<double, std::milli> frameTime = Clock::now() - m_frameStart;
+    m_current[static_cast<int>(ProfileZone::FRAME)] = frameTime.count();
+    
+    std::copy(m_current, m_current + ZONE_COUNT, m_history.begin() + m_nextFrame * ZONE_COUNT);
+    m_frameNumbers[m_nextFrame] = m_frameNumber++;
+    m_nextFrame = (m_nextFrame + 1) % m_historyFrames;
+    m_historySize = std::min(m_historySize + 1, m_historyFrames);
+}
+
+void Profiler::AddTime(ProfileZone zone, double milliseconds) {
+    m_current[static_cast<int>(zone)] += milliseconds;
+}
+
+Profiler::ZoneStats Profiler::GetStats(ProfileZone zone) const {
+    ZoneStats stats = {0, 0, 0, 0};
+    if (m_historySize == 0) {
+        return stats;
+    }
+    
+    int column = static_cast<int>(zone);
+    m_scratch.clear();
+    double total = 0;
+    for (size_t age = 0; age < m_historySize; age++) {
+        double value = m_history[HistoryIndex(age) * ZONE_COUNT + column];
+        m_scratch.push_back(value);
+        total += value;
+    }
+    
+    stats.last = m_history[HistoryIndex(m_historySize - 1) * ZONE_COUNT + column];
+    stats.average = total / m_historySize;
+    stats.minimum = *std::min_element(m_scratch.begin(), m_scratch.end());
+    
+    // Nearest-rank 99th percentile
+    size_t rank = (m_scratch.size() * 99 + 99) / 100;
+    std::nth_element(m_scratch.begin(), m_scratch.begin() + (rank - 1), m_scratch.end());
+    stats.p99 = m_scratch[rank - 1];
+    return stats;
+}
+
+bool Profiler::WriteCsv(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    
+    file << "frame";
+    for (int zone = 0; zone < ZONE_COUNT; zone++) {
+        file << "," << GetZoneName(static_cast<ProfileZone>(zone));
+    }
+    file << "\n";
+    
+    for (size_t age = 0; age < m_historySize; age++) {
+        size_t index = HistoryIndex(age);
+        file << m_frameNumbers[index];
+        for (int zone = 0; zone < ZONE_COUNT; zone++) {
+            file << "," << m_history[index * ZONE_COUNT + zone];
+        }
+        file << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+void Profiler::PrintSummary(std::ostream& out) const {
+    char line[96];
+    std::snprintf(line, sizeof(line), "  %-20s %9s %9s %9s  (ms, last %zu frames)\n", "zone", "min", "avg", "p99",
+                  m_historySize);
+    out << line;
+    
+    for (int zone = 0; zone < ZONE_COUNT; zone++) {
+        ZoneStats stats = GetStats(static_cast<ProfileZone>(zone));
+        if (stats.p99 <= 0) {
+            continue;
+        }
+        std::snprintf(line, sizeof(line), "  %-20s %9.4f %9.4f %9.4f\n", GetZoneName(static_cast<ProfileZone>(zone)),
+                      stats.minimum, stats.average, stats.p99);
+        out << line;
+    }
+}
+
+const char* Profiler::GetZoneName(ProfileZone zone) {
+    switch (zone) {
+        case ProfileZone::FRAME: return "frame";
+        case ProfileZone::EVENTS: return "events";
+        case ProfileZone::UPDATE: return "update";
+        case ProfileZone::ENTITY_UPDATE: return "entity_update";
+        case ProfileZone::PARTICLE_UPDATE: return "particle_update";
+        case ProfileZone::PLATFORM_COLLISIONS: return "platform_collisions";
+        case ProfileZone::ENEMY_COLLISIONS: return "enemy_collisions";
+        case ProfileZone::PICKUPS: return "pickups";
+        case ProfileZone::RENDER_BACKGROUND: return "render_background";
+        case ProfileZone::RENDER_WORLD: return "render_world";
+        case ProfileZone::RENDER_PARTICLES: return "render_particles";
+        case ProfileZone::RENDER_UI: return "render_ui";
+        case ProfileZone::PRESENT: return "present";
+        case ProfileZone::COUNT: break;
+    }
+    return "unknown";
+}
+
+size_t Profiler::HistoryIndex(size_t age) const {
+    // age 0 is the oldest frame still in the history
+    size_t oldest = (m_nextFrame + m_historyFrames - m_historySize) % m_historyFrames;
+    return (oldest + age) % m_historyFrames;
+}
\ No newline at end of file
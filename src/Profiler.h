@@ -0,0 +1,99 @@
+#pragma once
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Timed sections of a frame. Sub-phases are listed right after the zone that contains them.
+enum class ProfileZone {
+    FRAME,
+    EVENTS,
+    UPDATE,
+    ENTITY_UPDATE,
+    PARTICLE_UPDATE,
+    PLATFORM_COLLISIONS,
+    ENEMY_COLLISIONS,
+    PICKUPS,
+    RENDER_BACKGROUND,
+    RENDER_WORLD,
+    RENDER_PARTICLES,
+    RENDER_UI,
+    PRESENT,
+    COUNT
+};
+
+// Frame profiler. Zones accumulate time during a frame (an update zone may run
+// several ticks per frame); EndFrame() moves the totals into a rolling history
+// used for min/avg/p99 statistics and CSV export. No SDL dependency, so the
+// simulation can be profiled headless too.
+class Profiler {
+public:
+    struct ZoneStats {
+        double minimum;   // Milliseconds
+        double average;
+        double p99;
+        double last;
+    };
+    
+    explicit Profiler(size_t historyFrames = 300);
+    
+    void BeginFrame();
+    void EndFrame();
+    void AddTime(ProfileZone zone, double milliseconds);
+    
+    // Statistics over the frames currently in the history
+    ZoneStats GetStats(ProfileZone zone) const;
+    size_t GetHistorySize() const { return m_historySize; }
+    
+    // One row per frame in the history, oldest first, times in milliseconds
+    bool WriteCsv(const std::string& path) const;
+    
+    // min/avg/p99 table of every zone that recorded any time
+    void PrintSummary(std::ostream& out) const;
+    
+    static const char* GetZoneName(ProfileZone zone);
+    static const int ZONE_COUNT = static_cast<int>(ProfileZone::COUNT);
+    
+private:
+    typedef std::chrono::steady_clock Clock;
+    
+    size_t HistoryIndex(size_t age) const;
+    
+    std::vector<double> m_history;        // historyFrames x ZONE_COUNT
+    std::vector<long long> m_frameNumbers;
+    size_t m_historyFrames;
+    size_t m_historySize;
+    size_t m_nextFrame;
+    long long m_frameNumber;
+    
+    double m_current[ZONE_COUNT];
+    Clock::time_point m_frameStart;
+    
+    mutable std::vector<double> m_scratch; // Sorting buffer for percentiles
+};
+
+// Adds the time between construction and destruction to a zone.
+// A null profiler turns the scope into a no-op.
+class ProfileScope {
+public:
+    ProfileScope(Profiler* profiler, ProfileZone zone) : m_profiler(profiler), m_zone(zone) {
+        if (m_profiler) {
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+    
+    ~ProfileScope() {
+        if (m_profiler) {
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - m_start;
+            m_profiler->AddTime(m_zone, elapsed.count());
+        }
+    }
+    
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+    
+private:
+    Profiler* m_profiler;
+    ProfileZone m_zone;
+    std::chrono::steady_clock::time_point m_start;
+};
\ No newline at end of file
@@ -0,0 +1,17 @@
+#include "Random.h"
+
+void Random::Seed(std::uint64_t seed, RandomStream stream) {
+    // Reference PCG seeding: pick the stream, then mix the seed into the state
+    m_state = 0;
+    m_increment = (static_cast<std::uint64_t>(stream) << 1) | 1;
+    Next();
+    m_state += seed;
+    Next();
+}
+
+void Random::Fill(float* values, size_t count, float a, float b) {
+    float scale = (b - a) * (1.0f / 16777216.0f);
+    for (size_t i = 0; i < count; i++) {
+        values[i] = a + (Next() >> 8) * scale;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Subsystems that draw random numbers. Each gets its own stream of the
+// session seed, so drawing more numbers in one never shifts the sequence
+// another one sees.
+enum class RandomStream : std::uint64_t {
+    PARTICLES = 1,
+    LEVEL_GENERATION = 2
+};
+
+// PCG32 (XSH-RR) generator: 16 bytes of state and a handful of integer
+// operations per number, with 2^63 independent streams per seed. The same
+// seed and stream give the same sequence on every platform.
+class Random {
+public:
+    explicit Random(std::uint64_t seed = 0, RandomStream stream = RandomStream::PARTICLES) { Seed(seed, stream); }
+    
+    void Seed(std::uint64_t seed, RandomStream stream);
+    
+    std::uint32_t Next() {
+        std::uint64_t state = m_state;
+        m_state = state * MULTIPLIER + m_increment;
+        std::uint32_t xorShifted = static_cast<std::uint32_t>(((state >> 18) ^ state) >> 27);
+        std::uint32_t rotation = static_cast<std::uint32_t>(state >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+    }
+    
+    // Uniform in [0, 1), from the top 24 bits so every value is exact
+    float NextFloat() { return (Next() >> 8) * (1.0f / 16777216.0f); }
+    // Uniform between a and b (either may be the larger)
+    float NextFloat(float a, float b) { return a + NextFloat() * (b - a); }
+    // Uniform in [min, max]
+    int NextInt(int min, int max) {
+        std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - min + 1);
+        return min + static_cast<int>((Next() * range) >> 32);
+    }
+    
+    // count values uniform between a and b, for emitting a whole burst at once
+    void Fill(float* values, size_t count, float a, float b);
+    
+private:
+    static const std::uint64_t MULTIPLIER = 6364136223846793005ULL;
+    
+    std::uint64_t m_state;
+    std::uint64_t m_increment;  // Selects the stream; always odd
+};
\ No newline at end of file
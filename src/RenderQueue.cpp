@@ -0,0 +1,264 @@
+#include "RenderQueue.h"
+#include <algorithm>
+#include <cstdlib>
+
+// Sort key layout (most significant first):
+//   layer (8) | step (8) | kind (8) | unused (8) | payload (32)
+// The payload is the packed RGBA colour for plain fills and the texture slot
+// for geometry, so fills batch per colour and geometry batches per texture.
+static const int LAYER_SHIFT = 56;
+static const int STEP_SHIFT = 48;
+static const int KIND_SHIFT = 40;
+
+RenderQueue::RenderQueue() 
+    : m_layer(RenderLayer::PLATFORMS), m_step(0), m_offsetX(0), m_offsetY(0), m_lastDrawCallCount(0) {
+    m_color = {255, 255, 255, 255};
+    m_textures.push_back(nullptr);
+    m_commands.reserve(4096);
+}
+
+void RenderQueue::SetLayer(RenderLayer layer) {
+    m_layer = layer;
+    m_step = 0;
+}
+
+void RenderQueue::BeginItem() {
+    m_step = 0;
+}
+
+void RenderQueue::SetDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+    m_color = {r, g, b, a};
+    if (m_step < 255) {
+        m_step++;
+    }
+}
+
+void RenderQueue::SetOffset(int x, int y) {
+    m_offsetX = x;
+    m_offsetY = y;
+}
+
+void RenderQueue::FillRect(const SDL_Rect& rect) {
+    if (rect.w <= 0 || rect.h <= 0) return;
+    PushFill(rect);
+}
+
+void RenderQueue::DrawRect(const SDL_Rect& rect) {
+    if (rect.w <= 0 || rect.h <= 0) return;
+    
+    // Outline as up to four non-overlapping edges so blended colours are not applied twice
+    PushFill({rect.x, rect.y, rect.w, 1});
+    if (rect.h > 1) {
+        PushFill({rect.x, rect.y + rect.h - 1, rect.w, 1});
+    }
+    if (rect.h > 2) {
+        PushFill({rect.x, rect.y + 1, 1, rect.h - 2});
+        if (rect.w > 1) {
+            PushFill({rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2});
+        }
+    }
+}
+
+void RenderQueue::DrawLine(int x1, int y1, int x2, int y2) {
+    // Axis-aligned lines are a single rectangle
+    if (y1 == y2) {
+        PushFill({std::min(x1, x2), y1, std::abs(x2 - x1) + 1, 1});
+        return;
+    }
+    if (x1 == x2) {
+        PushFill({x1, std::min(y1, y2), 1, std::abs(y2 - y1) + 1});
+        return;
+    }
+    
+    // Bresenham, emitting one rectangle per run of pixels along the major axis
+    int dx = std::abs(x2 - x1);
+    int dy = -std::abs(y2 - y1);
+    int stepX = x1 < x2 ? 1 : -1;
+    int stepY = y1 < y2 ? 1 : -1;
+    bool steep = -dy > dx;
+    int error = dx + dy;
+    int x = x1;
+    int y = y1;
+    SDL_Rect run = {x, y, 1, 1};
+    
+    while (x != x2 || y != y2) {
+        int doubled = 2 * error;
+        bool movedX = false;
+        bool movedY = false;
+        if (doubled >= dy) {
+            error += dy;
+            x += stepX;
+            movedX = true;
+        }
+        if (doubled <= dx) {
+            error += dx;
+            y += stepY;
+            movedY = true;
+        }
+        
+        if (!steep && !movedY) {
+            run.w++;
+            if (stepX < 0) run.x--;
+        } else if (steep && !movedX) {
+            run.h++;
+            if (stepY < 0) run.y--;
+        } else {
+            PushFill(run);
+            run = {x, y, 1, 1};
+        }
+    }
+    PushFill(run);
+}
+
+void RenderQueue::DrawPoint(int x, int y) {
+    PushFill({x, y, 1, 1});
+}
+
+void RenderQueue::FillQuad(const SDL_Rect& rect) {
+    if (rect.w <= 0 || rect.h <= 0) return;
+    PushGeometry(0, rect, {0, 0, 0, 0});
+}
+
+void RenderQueue::DrawTexture(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& destination) {
+    if (!texture || destination.w <= 0 || destination.h <= 0) return;
+    PushGeometry(GetTextureSlot(texture), destination, source);
+}
+
+void RenderQueue::Clear() {
+    m_commands.clear();
+    m_textures.resize(1);
+    m_layer = RenderLayer::PLATFORMS;
+    m_step = 0;
+}
+
+void RenderQueue::Submit(SDL_Renderer* renderer) {
+    m_lastDrawCallCount = 0;
+    std::sort(m_commands.begin(), m_commands.end());
+    
+    size_t begin = 0;
+    while (begin < m_commands.size()) {
+        size_t end = begin + 1;
+        std::uint64_t key = m_commands[begin].key;
+        while (end < m_commands.size() && m_commands[end].key == key) {
+            end++;
+        }
+        
+        Kind kind = static_cast<Kind>((key >> KIND_SHIFT) & 0xFF);
+        if (kind == KIND_FILL) {
+            m_rectBatch.clear();
+            for (size_t i = begin; i < end; i++) {
+                m_rectBatch.push_back(m_commands[i].rect);
+            }
+            const SDL_Color& color = m_commands[begin].color;
+            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+            SDL_RenderFillRects(renderer, m_rectBatch.data(), static_cast<int>(m_rectBatch.size()));
+        } else {
+            SubmitGeometry(renderer, begin, end);
+        }
+        m_lastDrawCallCount++;
+        begin = end;
+    }
+    
+    Clear();
+}
+
+void RenderQueue::SubmitGeometry(SDL_Renderer* renderer, size_t begin, size_t end) {
+    std::uint32_t slot = static_cast<std::uint32_t>(m_commands[begin].key & 0xFFFFFFFF);
+    SDL_Texture* texture = m_textures[slot];
+    
+    float inverseWidth = 0;
+    float inverseHeight = 0;
+    if (texture) {
+        int width = 0;
+        int height = 0;
+        SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
+        inverseWidth = width > 0 ? 1.0f / width : 0;
+        inverseHeight = height > 0 ? 1.0f / height : 0;
+    }
+    
+    m_vertices.clear();
+    m_indices.clear();
+    for (size_t i = begin; i < end; i++) {
+        const Command& command = m_commands[i];
+        float left = static_cast<float>(command.rect.x);
+        float top = static_cast<float>(command.rect.y);
+        float right = left + command.rect.w;
+        float bottom = top + command.rect.h;
+        float u0 = command.source.x * inverseWidth;
+        float v0 = command.source.y * inverseHeight;
+        float u1 = (command.source.x + command.source.w) * inverseWidth;
+        float v1 = (command.source.y + command.source.h) * inverseHeight;
+        
+        int first = static_cast<int>(m_vertices.size());
+        m_vertices.push_back({{left, top}, command.color, {u0, v0}});
+        m_vertices.push_back({{right, top}, command.color, {u1, v0}});
+        m_vertices.push_back({{right, bottom}, command.color, {u1, v1}});
+        m_vertices.push_back({{left, bottom}, command.color, {u0, v1}});
+        
+        m_indices.push_back(first);
+        m_indices.push_back(first + 1);
+        m_indices.push_back(first + 2);
+        m_indices.push_back(first);
+        m_indices.push_back(first + 2);
+        m_indices.push_back(first + 3);
+    }
+    
+    SDL_RenderGeometry(renderer, texture, m_vertices.data(), static_cast<int>(m_vertices.size()),
+                       m_indices.data(), static_cast<int>(m_indices.size()));
+}
+
+std::uint64_t RenderQueue::MakeKey(Kind kind, std::uint32_t payload) const {
+    return (static_cast<std::uint64_t>(m_layer) << LAYER_SHIFT) |
+           (static_cast<std::uint64_t>(m_step) << STEP_SHIFT) |
+           (static_cast<std::uint64_t>(kind) << KIND_SHIFT) |
+           payload;
+}
+
+std::uint32_t RenderQueue::GetTextureSlot(SDL_Texture* texture) {
+    // Only a handful of textures are used per frame, so a linear search is fine
+    for (size_t i = 1; i < m_textures.size(); i++) {
+        if (m_textures[i] == texture) {
+            return static_cast<std::uint32_t>(i);
+        }
+    }
+    m_textures.push_back(texture);
+    return static_cast<std::uint32_t>(m_textures.size() - 1);
+}
+
+void RenderQueue::PushFill(const SDL_Rect& recorded) {
+    SDL_Rect rect = {recorded.x - m_offsetX, recorded.y - m_offsetY, recorded.w, recorded.h};
+    std::uint32_t packedColor = (static_cast<std::uint32_t>(m_color.r) << 24) |
+                                (static_cast<std::uint32_t>(m_color.g) << 16) |
+                                (static_cast<std::uint32_t>(m_color.b) << 8) |
+                                m_color.a;
+    std::uint64_t key = MakeKey(KIND_FILL, packedColor);
+    
+    // Merge with the previous rectangle when it continues the same row
+    // (filled shapes drawn point by point collapse into a few spans)
+    if (!m_commands.empty()) {
+        Command& last = m_commands.back();
+        if (last.key == key && last.rect.y == rect.y && last.rect.h == rect.h &&
+            last.rect.x + last.rect.w == rect.x) {
+            last.rect.w += rect.w;
+            return;
+        }
+    }
+    
+    Command command;
+    command.key = key;
+    command.sequence = static_cast<std::uint32_t>(m_commands.size());
+    command.rect = rect;
+    command.source = {0, 0, 0, 0};
+    command.color = m_color;
+    m_commands.push_back(command);
+}
+
+void RenderQueue::PushGeometry(std::uint32_t textureSlot, const SDL_Rect& rect, const SDL_Rect& source) {
+    Command command;
+    command.key = MakeKey(KIND_GEOMETRY, textureSlot);
+    command.sequence = static_cast<std::uint32_t>(m_commands.size());
+    command.rect = {rect.x - m_offsetX, rect.y - m_offsetY, rect.w, rect.h};
+    command.source = source;
+    command.color = m_color;
+    m_commands.push_back(command);
+}
\ No newline at end of file
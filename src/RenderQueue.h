@@ -0,0 +1,100 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Coarse draw order; lower layers are drawn first
+enum class RenderLayer : std::uint8_t {
+    PLATFORMS,
+    MOVING_PLATFORMS,
+    COINS,
+    POWER_UPS,
+    ENEMIES,
+    PLAYER,
+    PARTICLES,
+    GOAL,
+    TEXT
+};
+
+// Command buffer for world drawing. Entities record rectangles, lines, points
+// and textured quads instead of calling SDL directly; Submit() sorts the
+// commands by layer, step, texture and colour and sends every run that shares
+// a draw state as one SDL_RenderFillRects or SDL_RenderGeometry call.
+//
+// Each entity starts with BeginItem(); every SetDrawColor() after that is a
+// new step, so an entity's own painter order is kept while the same step of
+// all entities in a layer is batched together. Overlapping entities in the
+// same layer can therefore interleave their details.
+class RenderQueue {
+public:
+    RenderQueue();
+    
+    void SetLayer(RenderLayer layer);
+    void BeginItem();
+    void SetDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a = 255);
+    
+    // Subtracted from every position recorded after this call: the camera
+    // for world drawing, (0, 0) for screen-space UI
+    void SetOffset(int x, int y);
+    
+    // Same results as the SDL_Render* functions of the same name
+    void FillRect(const SDL_Rect& rect);
+    void DrawRect(const SDL_Rect& rect);
+    void DrawLine(int x1, int y1, int x2, int y2);
+    void DrawPoint(int x, int y);
+    
+    // Filled rectangle that carries its colour in the vertices, so quads of
+    // many different colours (e.g. fading particles) share a single draw call
+    void FillQuad(const SDL_Rect& rect);
+    
+    // Textured quad tinted by the current draw colour
+    void DrawTexture(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& destination);
+    
+    // Draw everything recorded since the last Submit() and empty the queue
+    void Submit(SDL_Renderer* renderer);
+    void Clear();
+    
+    size_t GetCommandCount() const { return m_commands.size(); }
+    int GetLastDrawCallCount() const { return m_lastDrawCallCount; }
+    
+private:
+    enum Kind : std::uint8_t {
+        KIND_FILL,
+        KIND_GEOMETRY
+    };
+    
+    struct Command {
+        std::uint64_t key;
+        std::uint32_t sequence;
+        SDL_Rect rect;
+        SDL_Rect source;
+        SDL_Color color;
+        
+        bool operator<(const Command& other) const {
+            return key < other.key || (key == other.key && sequence < other.sequence);
+        }
+    };
+    
+    std::uint64_t MakeKey(Kind kind, std::uint32_t payload) const;
+    std::uint32_t GetTextureSlot(SDL_Texture* texture);
+    void PushFill(const SDL_Rect& rect);
+    void PushGeometry(std::uint32_t textureSlot, const SDL_Rect& rect, const SDL_Rect& source);
+    void SubmitGeometry(SDL_Renderer* renderer, size_t begin, size_t end);
+    
+    RenderLayer m_layer;
+    std::uint8_t m_step;
+    SDL_Color m_color;
+    int m_offsetX;
+    int m_offsetY;
+    
+    std::vector<Command> m_commands;
+    std::vector<SDL_Texture*> m_textures; // Slot 0 is "no texture"
+    
+    // Scratch buffers reused between frames
+    std::vector<SDL_Rect> m_rectBatch;
+    std::vector<SDL_Vertex> m_vertices;
+    std::vector<int> m_indices;
+    
+    int m_lastDrawCallCount;
+};
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "ScenarioGenerator.h"
+#include "World.h"
+#include "Enemy.h"
+#include "Random.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+// Layout constants (pixels)
+static const float SLOT_WIDTH = 120.0f;       // Horizontal space per platform at density 1
+static const float START_MARGIN = 250.0f;     // Kept free around the player spawn
+static const float END_MARGIN = 100.0f;
+static const float GROUND_HEIGHT = 50.0f;
+static const float TIER_HEIGHT = 80.0f;       // Below the ~100 px a jump clears
+static const int MAX_TIER = 5;
+
+ScenarioParameters::ScenarioParameters() 
+    : platforms(8), horizontalPlatforms(2), verticalPlatforms(1), circularPlatforms(1), 
+      enemies(4), coins(12), powerUps(3), particleEmitters(0), density(1.0f), seed(1) {
+}
+
+void ScenarioParameters::Scale(float factor) {
+    auto scale = [factor](int count) { return static_cast<int>(std::lround(count * factor)); };
+    platforms = scale(platforms);
+    horizontalPlatforms = scale(horizontalPlatforms);
+    verticalPlatforms = scale(verticalPlatforms);
+    circularPlatforms = scale(circularPlatforms);
+    enemies = scale(enemies);
+    coins = scale(coins);
+    powerUps = scale(powerUps);
+    particleEmitters = scale(particleEmitters);
+}
+
+int ScenarioParameters::CountEntities() const {
+    return platforms + horizontalPlatforms + verticalPlatforms + circularPlatforms + 
+           enemies + coins + powerUps + particleEmitters;
+}
+
+bool ScenarioParameters::Parse(const std::string& specification) {
+    std::stringstream stream(specification);
+    std::string pair;
+    while (std::getline(stream, pair, ',')) {
+        size_t equals = pair.find('=');
+        if (equals == std::string::npos) {
+            return false;
+        }
+        
+        std::string key = pair.substr(0, equals);
+        const char* value = pair.c_str() + equals + 1;
+        int count = std::max(0, std::atoi(value));
+        
+        if (key == "platforms") platforms = count;
+        else if (key == "horizontal") horizontalPlatforms = count;
+        else if (key == "vertical") verticalPlatforms = count;
+        else if (key == "circular") circularPlatforms = count;
+        else if (key == "moving") {
+            horizontalPlatforms = count - 2 * (count / 3);
+            verticalPlatforms = count / 3;
+            circularPlatforms = count / 3;
+        }
+        else if (key == "enemies") enemies = count;
+        else if (key == "coins") coins = count;
+        else if (key == "powerups") powerUps = count;
+        else if (key == "emitters") particleEmitters = count;
+        else if (key == "density") density = static_cast<float>(std::atof(value));
+        else if (key == "seed") seed = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        else if (key == "scale") Scale(static_cast<float>(std::atof(value)));
+        else return false;
+    }
+    return density > 0;
+}
+
+ScenarioParameters ScenarioParameters::ForEntityCount(int entityCount) {
+    ScenarioParameters parameters;
+    parameters.particleEmitters = 1;
+    parameters.Scale(std::max(1.0f, entityCount / static_cast<float>(parameters.CountEntities())));
+    return parameters;
+}
+
+LevelLayout ScenarioGenerator::Generate(const ScenarioParameters& parameters) {
+    Random random(parameters.seed, RandomStream::LEVEL_GENERATION);
+    
+    const float height = static_cast<float>(World::HEIGHT);
+    const float groundY = height - GROUND_HEIGHT;
+    const float slotWidth = std::max(20.0f, SLOT_WIDTH / parameters.density);
+    
+    // Enough slots for every platform, and for the ground content to breathe
+    int movingCount = parameters.horizontalPlatforms + parameters.verticalPlatforms + parameters.circularPlatforms;
+    int slots = std::max({1, parameters.platforms, movingCount, parameters.enemies / 2, parameters.coins / 3});
+    float width = std::max(static_cast<float>(World::WIDTH), START_MARGIN + slots * slotWidth + END_MARGIN);
+    float contentWidth = width - START_MARGIN - END_MARGIN;
+    
+    LevelLayout layout(width, height, Vector2(50.0f, height - 100.0f));
+    
+    // Continuous ground keeps every generated level completable
+    layout.platforms.push_back({0, groundY, width, GROUND_HEIGHT});
+    
+    // Static platforms: a random walk over tiers, one step at a time
+    float platformWidth = std::min(100.0f, std::max(40.0f, slotWidth * 0.8f));
+    int tier = 0;
+    layout.platforms.reserve(parameters.platforms + 1);
+    for (int i = 0; i < parameters.platforms; i++) {
+        int step = static_cast<int>(random.NextFloat() * 3.0f) - 1;
+        tier = std::min(MAX_TIER, std::max(0, tier + step));
+        float x = START_MARGIN + i * (contentWidth / std::max(1, parameters.platforms)) + random.NextFloat() * slotWidth * 0.2f;
+        float y = groundY - TIER_HEIGHT * (tier + 1);
+        layout.platforms.push_back({x, y, platformWidth, 15});
+    }
+    
+    // Moving platforms spread evenly above the static ones
+    MovementType types[] = {MovementType::HORIZONTAL, MovementType::VERTICAL, MovementType::CIRCULAR};
+    int typeCounts[] = {parameters.horizontalPlatforms, parameters.verticalPlatforms, parameters.circularPlatforms};
+    int movingIndex = 0;
+    layout.movingPlatforms.reserve(movingCount);
+    for (int type = 0; type < 3; type++) {
+        for (int i = 0; i < typeCounts[type]; i++, movingIndex++) {
+            float x = START_MARGIN + (movingIndex + 0.5f) * (contentWidth / movingCount);
+            float y = groundY - TIER_HEIGHT * (1 + movingIndex % MAX_TIER) - 40.0f;
+            float speed = 40.0f + random.NextFloat() * 40.0f;
+            float range = (types[type] == MovementType::HORIZONTAL) ? 60.0f : 35.0f;
+            layout.movingPlatforms.push_back({x, y, 60, 12, types[type], speed, range});
+        }
+    }
+    
+    // Surface for the n-th of total entities of one type: every nth one is spread
+    // evenly over the ground, the rest go round-robin onto the static platforms
+    const int platformCount = parameters.platforms;
+    auto surface = [&](int n, int total, int everyNthOnGround, float& x, float& y) {
+        if (platformCount == 0 || n % everyNthOnGround == 0) {
+            int groundTotal = (platformCount == 0) ? total : (total + everyNthOnGround - 1) / everyNthOnGround;
+            int groundIndex = (platformCount == 0) ? n : n / everyNthOnGround;
+            x = START_MARGIN + (groundIndex + 0.5f) * (contentWidth / std::max(1, groundTotal));
+            y = groundY;
+            return;
+        }
+        const LevelLayout::PlatformRecord& platform = layout.platforms[1 + n % platformCount];
+        x = platform.x + random.NextFloat() * (platform.width - 25.0f);
+        y = platform.y;
+    };
+    
+    // Enemies: half on platforms, half walking the ground
+    layout.enemies.reserve(parameters.enemies);
+    for (int i = 0; i < parameters.enemies; i++) {
+        float x, y;
+        surface(i, parameters.enemies, 2, x, y);
+        layout.enemies.push_back({x, y - EnemyStore::HEIGHT});
+    }
+    
+    // Coins float within jumping reach above their surface; there is always one
+    // so the level can be completed
+    int coinCount = std::max(1, parameters.coins);
+    layout.coins.reserve(coinCount);
+    for (int i = 0; i < coinCount; i++) {
+        float x, y;
+        surface(i, coinCount, 3, x, y);
+        layout.coins.push_back({x, y - 40.0f});
+    }
+    
+    PowerUpType powerUpTypes[] = {PowerUpType::SUPER_MARIO, PowerUpType::SPEED_BOOST, PowerUpType::EXTRA_LIFE};
+    layout.powerUps.reserve(parameters.powerUps);
+    for (int i = 0; i < parameters.powerUps; i++) {
+        float x, y;
+        surface(i + 1, parameters.powerUps + 1, 4, x, y);
+        layout.powerUps.push_back({x, y - 40.0f, powerUpTypes[i % 3]});
+    }
+    
+    // Emitters hang in the sky and fire their effect every 0.5-2 s
+    ParticleEffect effects[] = {ParticleEffect::EXPLOSION, ParticleEffect::COIN, 
+                                ParticleEffect::JUMP, ParticleEffect::POWER_UP};
+    layout.emitters.reserve(parameters.particleEmitters);
+    for (int i = 0; i < parameters.particleEmitters; i++) {
+        float x = START_MARGIN + (i + 0.5f) * (contentWidth / parameters.particleEmitters);
+        float y = 80.0f + random.NextFloat() * 150.0f;
+        layout.emitters.push_back({x, y, effects[i % 4], 0.5f + random.NextFloat() * 1.5f});
+    }
+    
+    return layout;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include "LevelLayout.h"
+#include <cstdint>
+#include <string>
+
+// Entity counts and spacing for a generated level. The defaults match the
+// amount of content in the built-in levels.
+struct ScenarioParameters {
+    int platforms;
+    int horizontalPlatforms;   // Moving platforms, by MovementType
+    int verticalPlatforms;
+    int circularPlatforms;
+    int enemies;
+    int coins;
+    int powerUps;
+    int particleEmitters;
+    float density;             // 1 = built-in spacing, 2 = twice as much content per screen
+    std::uint32_t seed;
+    
+    ScenarioParameters();
+    
+    // Multiply every count by factor
+    void Scale(float factor);
+    int CountEntities() const;
+    
+    // Parse "key=value" pairs separated by commas, e.g. "scale=100,enemies=5000,density=2".
+    // Keys: platforms, horizontal, vertical, circular, moving (split evenly), enemies,
+    // coins, powerups, emitters, density, seed and scale (applies to the counts so far).
+    bool Parse(const std::string& specification);
+    
+    // Built-in proportions scaled to roughly this many entities in total
+    static ScenarioParameters ForEntityCount(int entityCount);
+};
+
+// Builds playable layouts of any size from ScenarioParameters: a continuous
+// ground, static platforms that climb and fall in steps a jump can clear,
+// moving platforms above them, and enemies, coins and power-ups placed on
+// reachable surfaces. The level grows wider instead of denser as counts rise,
+// unless density says otherwise. The same parameters always give the same layout.
+class ScenarioGenerator {
+public:
+    static LevelLayout Generate(const ScenarioParameters& parameters);
+};
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : m_cellSize(cellSize), m_inverseCellSize(1.0f / cellSize), m_columns(1), m_rows(1) {
+}
+
+void SpatialGrid::Begin(const Rectangle& worldBounds) {
+    m_worldBounds = worldBounds;
+    m_columns = std::max(1, static_cast<int>(std::ceil(worldBounds.width * m_inverseCellSize)));
+    m_rows = std::max(1, static_cast<int>(std::ceil(worldBounds.height * m_inverseCellSize)));
+    m_items.clear();
+    m_entries.clear();
+}
+
+int SpatialGrid::CellX(float x) const {
+    int cell = static_cast<int>(std::floor((x - m_worldBounds.x) * m_inverseCellSize));
+    return std::min(std::max(cell, 0), m_columns - 1);
+}
+
+int SpatialGrid::CellY(float y) const {
+    int cell = static_cast<int>(std::floor((y - m_worldBounds.y) * m_inverseCellSize));
+    return std::min(std::max(cell, 0), m_rows - 1);
+}
+
+void SpatialGrid::Insert(int id, const Rectangle& bounds) {
+    Item item;
+    item.id = id;
+    item.bounds = bounds;
+    item.minCellX = CellX(bounds.x);
+    item.minCellY = CellY(bounds.y);
+    
+    int itemIndex = static_cast<int>(m_items.size());
+    int maxCellX = CellX(bounds.x + bounds.width);
+    int maxCellY = CellY(bounds.y + bounds.height);
+    for (int cy = item.minCellY; cy <= maxCellY; cy++) {
+        for (int cx = item.minCellX; cx <= maxCellX; cx++) {
+            m_entries.push_back({cy * m_columns + cx, itemIndex});
+        }
+    }
+    m_items.push_back(item);
+}
+
+void SpatialGrid::Finish() {
+    std::sort(m_entries.begin(), m_entries.end());
+}
+
+void SpatialGrid::Query(const Rectangle& area, std::vector<int>& results) const {
+    results.clear();
+    if (m_entries.empty()) return;
+    
+    int minCellX = CellX(area.x);
+    int minCellY = CellY(area.y);
+    int maxCellX = CellX(area.x + area.width);
+    int maxCellY = CellY(area.y + area.height);
+    
+    for (int cy = minCellY; cy <= maxCellY; cy++) {
+        // Cells of one row are contiguous in the sorted entry list
+        int firstCell = cy * m_columns + minCellX;
+        int lastCell = cy * m_columns + maxCellX;
+        auto it = std::lower_bound(m_entries.begin(), m_entries.end(), CellEntry{firstCell, -1});
+        
+        for (; it != m_entries.end() && it->cell <= lastCell; ++it) {
+            const Item& item = m_items[it->item];
+            if (!item.bounds.Intersects(area)) continue;
+            
+            // An entity spanning several cells is reported only from the first
+            // cell shared by the entity and the query area
+            int cx = it->cell - cy * m_columns;
+            if (std::max(item.minCellX, minCellX) == cx && std::max(item.minCellY, minCellY) == cy) {
+                results.push_back(item.id);
+            }
+        }
+    }
+    
+    // Keep resolution order identical to a linear scan over the entity list
+    std::sort(results.begin(), results.end());
+}
+
+bool SpatialGrid::AnyContains(const Vector2& point) const {
+    if (m_entries.empty()) return false;
+    
+    int cell = CellY(point.y) * m_columns + CellX(point.x);
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), CellEntry{cell, -1});
+    for (; it != m_entries.end() && it->cell == cell; ++it) {
+        const Rectangle& bounds = m_items[it->item].bounds;
+        if (point.x >= bounds.x && point.x <= bounds.x + bounds.width &&
+            point.y >= bounds.y && point.y <= bounds.y + bounds.height) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "Types.h"
+#include <vector>
+
+// Uniform grid broad phase. Entities are bucketed by the cells their bounds
+// touch so queries only look at the neighbourhood of the query area instead
+// of every entity in the level.
+//
+// The grid is rebuilt in bulk: Begin(), Insert() each entity, Finish().
+// Static geometry is built once per level, dynamic entities once per tick.
+// Cells are stored as a sorted list of (cell, entity) pairs rather than a
+// dense cell array, so rebuild cost depends on the entity count only and not
+// on how large the world is.
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize = 64.0f);
+    
+    // Start a rebuild covering the given area (entities outside it are clamped to the edge cells)
+    void Begin(const Rectangle& worldBounds);
+    void Insert(int id, const Rectangle& bounds);
+    void Finish();
+    
+    // Collect the ids of all entities whose bounds intersect the area, sorted ascending
+    void Query(const Rectangle& area, std::vector<int>& results) const;
+    
+    // True if any entity's bounds contain the point (edges inclusive)
+    bool AnyContains(const Vector2& point) const;
+    
+    size_t Size() const { return m_items.size(); }
+    
+private:
+    struct Item {
+        int id;
+        Rectangle bounds;
+        int minCellX, minCellY;
+    };
+    
+    int CellX(float x) const;
+    int CellY(float y) const;
+    
+    float m_cellSize;
+    float m_inverseCellSize;
+    Rectangle m_worldBounds;
+    int m_columns;
+    int m_rows;
+    
+    struct CellEntry {
+        int cell;  // cellY * columns + cellX
+        int item;  // Index into m_items
+        bool operator<(const CellEntry& other) const {
+            return cell < other.cell || (cell == other.cell && item < other.item);
+        }
+    };
+    
+    std::vector<Item> m_items;
+    std::vector<CellEntry> m_entries; // Sorted by cell, then insertion order
+};
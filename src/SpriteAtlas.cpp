@@ -0,0 +1,159 @@
+#include "SpriteAtlas.h"
+#include "RenderQueue.h"
+#include <algorithm>
+#include <cmath>
+
+const int SpriteAtlas::ATLAS_WIDTH = 512;
+const int SpriteAtlas::FRAME_PADDING = 1; // Transparent gap so scaled frames don't bleed into each other
+
+SpriteAtlas::SpriteAtlas() : m_texture(nullptr) {
+    for (Sheet& sheet : m_sheets) {
+        sheet.frameCount = 0;
+        sheet.width = 0;
+        sheet.height = 0;
+        sheet.originX = 0;
+        sheet.originY = 0;
+        sheet.firstFrame = 0;
+    }
+}
+
+SpriteAtlas::~SpriteAtlas() {
+    Destroy();
+}
+
+void SpriteAtlas::AddSheet(SpriteSheet sheet, int frameCount, int width, int height, 
+                           int originX, int originY, DrawFunction draw) {
+    Sheet& entry = m_sheets[static_cast<int>(sheet)];
+    entry.frameCount = frameCount;
+    entry.width = width;
+    entry.height = height;
+    entry.originX = originX;
+    entry.originY = originY;
+    entry.draw = draw;
+}
+
+bool SpriteAtlas::Build(SDL_Renderer* renderer) {
+    Destroy();
+    
+    // Shelf packing: frames go left to right and wrap into a new row when full
+    m_frames.clear();
+    int cursorX = 0;
+    int cursorY = 0;
+    int rowHeight = 0;
+    for (Sheet& sheet : m_sheets) {
+        sheet.firstFrame = static_cast<int>(m_frames.size());
+        for (int frame = 0; frame < sheet.frameCount; frame++) {
+            if (cursorX + sheet.width > ATLAS_WIDTH) {
+                cursorX = 0;
+                cursorY += rowHeight + FRAME_PADDING;
+                rowHeight = 0;
+            }
+            m_frames.push_back({cursorX, cursorY, sheet.width, sheet.height});
+            cursorX += sheet.width + FRAME_PADDING;
+            rowHeight = std::max(rowHeight, sheet.height);
+        }
+    }
+    int atlasHeight = std::max(1, cursorY + rowHeight);
+    
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, atlasHeight, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) {
+        return false;
+    }
+    
+    SDL_Renderer* baker = SDL_CreateSoftwareRenderer(surface);
+    if (!baker) {
+        SDL_FreeSurface(surface);
+        return false;
+    }
+    
+    // Start fully transparent, then blend the primitives on top
+    SDL_SetRenderDrawBlendMode(baker, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(baker, 0, 0, 0, 0);
+    SDL_RenderClear(baker);
+    SDL_SetRenderDrawBlendMode(baker, SDL_BLENDMODE_BLEND);
+    
+    RenderQueue queue;
+    for (const Sheet& sheet : m_sheets) {
+        for (int frame = 0; frame < sheet.frameCount; frame++) {
+            const SDL_Rect& cell = m_frames[sheet.firstFrame + frame];
+            SDL_RenderSetClipRect(baker, &cell);
+            sheet.draw(queue, frame, cell.x + sheet.originX, cell.y + sheet.originY);
+            queue.Submit(baker);
+        }
+    }
+    SDL_RenderFlush(baker);
+    
+    m_texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_DestroyRenderer(baker);
+    SDL_FreeSurface(surface);
+    
+    if (!m_texture) {
+        return false;
+    }
+    SDL_SetTextureBlendMode(m_texture, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+void SpriteAtlas::Destroy() {
+    if (m_texture) {
+        SDL_DestroyTexture(m_texture);
+        m_texture = nullptr;
+    }
+}
+
+int SpriteAtlas::GetFrameCount(SpriteSheet sheet) const {
+    return m_sheets[static_cast<int>(sheet)].frameCount;
+}
+
+void SpriteAtlas::Draw(RenderQueue& queue, SpriteSheet sheet, int frame, int x, int y) const {
+    const Sheet* entry = FindSheet(sheet, frame);
+    if (!entry) return;
+    
+    if (!m_texture) {
+        entry->draw(queue, frame, x, y);
+        return;
+    }
+    
+    SDL_Rect destination = {x - entry->originX, y - entry->originY, entry->width, entry->height};
+    queue.SetDrawColor(255, 255, 255, 255);
+    queue.DrawTexture(m_texture, m_frames[entry->firstFrame + frame], destination);
+}
+
+void SpriteAtlas::DrawScaled(RenderQueue& queue, SpriteSheet sheet, int frame, const SDL_Rect& destination,
+                             int width, int height) const {
+    const Sheet* entry = FindSheet(sheet, frame);
+    if (!entry || width <= 0 || height <= 0) return;
+    
+    if (!m_texture) {
+        entry->draw(queue, frame, destination.x, destination.y);
+        return;
+    }
+    
+    // Scale the whole frame, including anything drawn outside the entity footprint
+    float scaleX = static_cast<float>(destination.w) / width;
+    float scaleY = static_cast<float>(destination.h) / height;
+    SDL_Rect scaled = {
+        destination.x - static_cast<int>(entry->originX * scaleX),
+        destination.y - static_cast<int>(entry->originY * scaleY),
+        static_cast<int>(entry->width * scaleX),
+        static_cast<int>(entry->height * scaleY)
+    };
+    queue.SetDrawColor(255, 255, 255, 255);
+    queue.DrawTexture(m_texture, m_frames[entry->firstFrame + frame], scaled);
+}
+
+int SpriteAtlas::PhaseToFrame(float phase, int frameCount) {
+    const float twoPi = 2.0f * 3.14159265f;
+    float wrapped = std::fmod(phase, twoPi);
+    if (wrapped < 0) wrapped += twoPi;
+    int frame = static_cast<int>(wrapped / twoPi * frameCount + 0.5f);
+    return frame % frameCount;
+}
+
+const SpriteAtlas::Sheet* SpriteAtlas::FindSheet(SpriteSheet sheet, int frame) const {
+    const Sheet& entry = m_sheets[static_cast<int>(sheet)];
+    if (!entry.draw || frame < 0 || frame >= entry.frameCount) {
+        return nullptr;
+    }
+    return &entry;
+}
\ No newline at end of file
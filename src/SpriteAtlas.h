@@ -0,0 +1,77 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <functional>
+#include <vector>
+
+class RenderQueue;
+
+// Every procedurally drawn visual that is baked into the atlas
+enum class SpriteSheet {
+    COIN,
+    POWER_UP,               // One frame per PowerUpType
+    ENEMY_RIGHT,
+    ENEMY_LEFT,
+    PLAYER_RIGHT,
+    PLAYER_LEFT,
+    PLAYER_POWERED_RIGHT,
+    PLAYER_POWERED_LEFT,
+    COUNT
+};
+
+// Texture atlas of pre-rendered entity frames. Entities register a draw
+// function per sheet, Build() rasterizes every frame once through a software
+// renderer and uploads the result as a single texture, and rendering then
+// records one textured quad per entity.
+//
+// If the atlas could not be built, Draw() falls back to recording the
+// original primitives so the game still renders.
+class SpriteAtlas {
+public:
+    // Draws one frame with the entity's origin at (x, y)
+    typedef std::function<void(RenderQueue& queue, int frame, int x, int y)> DrawFunction;
+    
+    SpriteAtlas();
+    ~SpriteAtlas();
+    
+    // Register a sheet before Build(). Frames are width x height pixels and the
+    // entity's origin sits at (originX, originY) inside each frame, so visuals
+    // may extend past the entity bounds.
+    void AddSheet(SpriteSheet sheet, int frameCount, int width, int height, 
+                  int originX, int originY, DrawFunction draw);
+    
+    bool Build(SDL_Renderer* renderer);
+    void Destroy();
+    bool IsBuilt() const { return m_texture != nullptr; }
+    
+    int GetFrameCount(SpriteSheet sheet) const;
+    
+    // Record a frame with the entity's origin at (x, y)
+    void Draw(RenderQueue& queue, SpriteSheet sheet, int frame, int x, int y) const;
+    
+    // Record a frame scaled so the entity's width x height footprint covers the destination
+    void DrawScaled(RenderQueue& queue, SpriteSheet sheet, int frame, const SDL_Rect& destination,
+                    int width, int height) const;
+    
+    // Frame index for a periodic animation phase in radians
+    static int PhaseToFrame(float phase, int frameCount);
+    
+private:
+    struct Sheet {
+        int frameCount;
+        int width;
+        int height;
+        int originX;
+        int originY;
+        int firstFrame;     // Index into m_frames
+        DrawFunction draw;
+    };
+    
+    const Sheet* FindSheet(SpriteSheet sheet, int frame) const;
+    
+    Sheet m_sheets[static_cast<int>(SpriteSheet::COUNT)];
+    std::vector<SDL_Rect> m_frames;
+    SDL_Texture* m_texture;
+    
+    static const int ATLAS_WIDTH;
+    static const int FRAME_PADDING;
+};
\ No newline at end of file
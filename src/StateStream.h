@@ -0,0 +1,131 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Largest coordinate or size an entity read back from a saved state may have.
+// Play never gets near it (a falling enemy stops moving in float precision
+// first), and it keeps every coordinate a valid cell index for the grids and
+// the collision map.
+const float MAX_STATE_COORDINATE = 1.0e8f;
+
+// Flat binary images of simulation state (see World::SaveState()). Values are
+// copied byte for byte in native byte order, and arrays as an element count
+// followed by the elements, so writing and reading an image is little more
+// than one memcpy per column. Images are read back by the same build only.
+class StateWriter {
+public:
+    // Appends to buffer; a buffer reused between saves stops allocating once it has grown to fit
+    explicit StateWriter(std::vector<std::uint8_t>& buffer) : m_buffer(buffer) {}
+    
+    template <typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "state is copied byte for byte");
+        WriteBytes(&value, sizeof(T));
+    }
+    
+    template <typename T>
+    void WriteArray(const T* values, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "state is copied byte for byte");
+        Write(static_cast<std::uint64_t>(count));
+        WriteBytes(values, count * sizeof(T));
+    }
+    
+    // A bool as one byte of 0 or 1 (see StateReader::ReadFlag())
+    void WriteFlag(bool value) { Write(static_cast<std::uint8_t>(value ? 1 : 0)); }
+    
+    // A store column (std::vector or ArenaVector)
+    template <typename Column>
+    void WriteColumn(const Column& column) { WriteArray(column.data(), column.size()); }
+    
+    void WriteBytes(const void* data, size_t size) {
+        size_t offset = m_buffer.size();
+        m_buffer.resize(offset + size);
+        if (size > 0) {
+            std::memcpy(m_buffer.data() + offset, data, size);
+        }
+    }
+    
+    size_t GetSize() const { return m_buffer.size(); }
+    // Overwrite a value written earlier at offset, e.g. a size known only at the end
+    template <typename T>
+    void Patch(size_t offset, const T& value) { std::memcpy(m_buffer.data() + offset, &value, sizeof(T)); }
+    
+private:
+    std::vector<std::uint8_t>& m_buffer;
+};
+
+// Reads an image written by StateWriter. Every read fails (and keeps failing)
+// once the image runs out, instead of reading past its end.
+class StateReader {
+public:
+    StateReader(const std::uint8_t* data, size_t size) : m_data(data), m_size(size), m_offset(0), m_failed(false) {}
+    
+    template <typename T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "state is copied byte for byte");
+        return ReadBytes(&value, sizeof(T));
+    }
+    
+    // A bool written by WriteFlag(); any byte other than 0 or 1 fails, since
+    // copying it into a bool would not give a valid bool
+    bool ReadFlag(bool& value) {
+        std::uint8_t stored;
+        if (!Read(stored) || stored > 1) {
+            return Fail();
+        }
+        value = stored == 1;
+        return true;
+    }
+    
+    // An array of at most capacity elements into values; its length goes to count
+    template <typename T>
+    bool ReadArray(T* values, size_t capacity, size_t& count) {
+        static_assert(std::is_trivially_copyable<T>::value, "state is copied byte for byte");
+        std::uint64_t stored;
+        if (!Read(stored) || stored > capacity || stored > (m_size - m_offset) / sizeof(T)) {
+            return Fail();
+        }
+        count = static_cast<size_t>(stored);
+        return ReadBytes(values, count * sizeof(T));
+    }
+    
+    // A store column, resized to the stored length
+    template <typename Column>
+    bool ReadColumn(Column& column) {
+        typedef typename Column::value_type T;
+        static_assert(std::is_trivially_copyable<T>::value, "state is copied byte for byte");
+        std::uint64_t stored;
+        if (!Read(stored) || stored > (m_size - m_offset) / sizeof(T)) {
+            return Fail();
+        }
+        column.resize(static_cast<size_t>(stored));
+        return ReadBytes(column.data(), column.size() * sizeof(T));
+    }
+    
+    bool ReadBytes(void* data, size_t size) {
+        if (m_failed || size > m_size - m_offset) {
+            return Fail();
+        }
+        if (size > 0) {
+            std::memcpy(data, m_data + m_offset, size);
+        }
+        m_offset += size;
+        return true;
+    }
+    
+    bool IsAtEnd() const { return !m_failed && m_offset == m_size; }
+    
+private:
+    bool Fail() {
+        m_failed = true;
+        return false;
+    }
+    
+    const std::uint8_t* m_data;
+    size_t m_size;
+    size_t m_offset;
+    bool m_failed;
+};
@@ -0,0 +1,98 @@
+#include "StaticLayer.h"
+#include "Platform.h"
+#include <algorithm>
+#include <cmath>
+
+StaticLayer::StaticLayer() 
+    : m_height(0), m_levelLoad(0), m_isValid(false), m_useTextures(false) {
+}
+
+StaticLayer::~StaticLayer() {
+    Destroy();
+}
+
+void StaticLayer::Destroy() {
+    for (Tile& tile : m_tiles) {
+        if (tile.texture) {
+            SDL_DestroyTexture(tile.texture);
+        }
+    }
+    m_tiles.clear();
+    m_isValid = false;
+}
+
+void StaticLayer::Render(SDL_Renderer* renderer, RenderQueue& queue, const PlatformStore& platforms, const Rectangle& view,
+                         int cameraX, std::uint32_t levelLoad) {
+    int height = static_cast<int>(std::ceil(view.height));
+    if (!m_isValid || height != m_height) {
+        Destroy();
+        m_height = height;
+        m_levelLoad = levelLoad;
+        m_isValid = true;
+        m_useTextures = SDL_RenderTargetSupported(renderer) == SDL_TRUE;
+    } else if (levelLoad != m_levelLoad) {
+        // New level: keep the textures, redraw every strip
+        for (Tile& tile : m_tiles) {
+            tile.index = -1;
+        }
+        m_levelLoad = levelLoad;
+    }
+    
+    if (!m_useTextures) {
+        platforms.Render(queue, view);
+        return;
+    }
+    
+    int first = static_cast<int>(std::floor(view.x / TILE_WIDTH));
+    int last = static_cast<int>(std::floor((view.x + view.width) / TILE_WIDTH));
+    for (int index = first; index <= last; index++) {
+        auto cached = std::find_if(m_tiles.begin(), m_tiles.end(), [index](const Tile& tile) { return tile.index == index; });
+        if (cached == m_tiles.end()) {
+            // Reuse a strip that is out of view, or add one; the camera only
+            // scrolls forward, so a strip that left the view is rarely needed again
+            cached = std::find_if(m_tiles.begin(), m_tiles.end(), [first, last](const Tile& tile) {
+                return tile.index < first || tile.index > last;
+            });
+            if (cached == m_tiles.end()) {
+                m_tiles.push_back({-1, nullptr});
+                cached = m_tiles.end() - 1;
+            }
+            if (!Draw(renderer, platforms, *cached, index)) {
+                // Stop caching for good and draw this frame directly
+                Destroy();
+                m_isValid = true;
+                m_useTextures = false;
+                platforms.Render(queue, view);
+                return;
+            }
+        }
+        
+        SDL_Rect destination = {index * TILE_WIDTH - cameraX, 0, TILE_WIDTH, m_height};
+        SDL_RenderCopy(renderer, cached->texture, nullptr, &destination);
+    }
+}
+
+bool StaticLayer::Draw(SDL_Renderer* renderer, const PlatformStore& platforms, Tile& tile, int index) {
+    if (!tile.texture) {
+        tile.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, TILE_WIDTH, m_height);
+        if (!tile.texture) {
+            return false;
+        }
+        SDL_SetTextureBlendMode(tile.texture, SDL_BLENDMODE_BLEND);
+    }
+    if (SDL_SetRenderTarget(renderer, tile.texture) != 0) {
+        return false;
+    }
+    tile.index = index;
+    
+    // Start transparent so the background shows between the platforms
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    
+    int left = index * TILE_WIDTH;
+    m_queue.SetOffset(left, 0);
+    platforms.Render(m_queue, Rectangle(static_cast<float>(left), 0, TILE_WIDTH, static_cast<float>(m_height)));
+    m_queue.Submit(renderer);
+    SDL_SetRenderTarget(renderer, nullptr);
+    return true;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include "Types.h"
+#include "RenderQueue.h"
+#include <cstdint>
+#include <vector>
+
+class PlatformStore;
+
+// Static platforms drawn once into textures and copied to the screen every
+// frame, so dense level geometry costs a few copies per frame however many
+// platforms are in view. The level is cut into TILE_WIDTH wide strips; a
+// strip is drawn when it first scrolls into view and kept until the level is
+// reloaded. Strips are drawn from the streamed-in platforms, which always
+// cover the strips touching the view since the level is streamed in at least
+// one strip ahead and released at least one strip behind it.
+//
+// Without render-target support the platforms are recorded into the frame's
+// queue every frame instead.
+class StaticLayer {
+public:
+    StaticLayer();
+    ~StaticLayer();
+    
+    // Force every strip to be redrawn (render targets reset)
+    void Invalidate() { m_isValid = false; }
+    void Destroy();
+    
+    // Draw the platforms in view, cameraX being the queue's offset for the
+    // frame. levelLoad identifies the level geometry (World::GetLevelLoadCount()).
+    void Render(SDL_Renderer* renderer, RenderQueue& queue, const PlatformStore& platforms, const Rectangle& view,
+                int cameraX, std::uint32_t levelLoad);
+    
+    static const int TILE_WIDTH = 512;
+    
+private:
+    struct Tile {
+        int index;  // Strip [index * TILE_WIDTH, (index + 1) * TILE_WIDTH), -1 if the texture is unused
+        SDL_Texture* texture;
+    };
+    
+    bool Draw(SDL_Renderer* renderer, const PlatformStore& platforms, Tile& tile, int index);
+    
+    std::vector<Tile> m_tiles;
+    RenderQueue m_queue;  // Records one strip at a time
+    int m_height;
+    std::uint32_t m_levelLoad;
+    bool m_isValid;
+    bool m_useTextures;
+};
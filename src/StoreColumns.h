@@ -0,0 +1,78 @@
+#pragma once
+#include "StateStream.h"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+// Helpers shared by the structure-of-arrays entity stores
+
+// Flag the entities whose right edge (x + width) lies left of limit.
+// Returns how many were flagged; keep[i] is 0 for those and 1 otherwise.
+template <typename Column, typename Flags>
+size_t MarkLeftOf(const Column& x, float width, float limit, Flags& keep) {
+    keep.resize(x.size());
+    size_t removed = 0;
+    for (size_t i = 0; i < x.size(); i++) {
+        keep[i] = x[i] + width >= limit;
+        removed += !keep[i];
+    }
+    return removed;
+}
+
+template <typename Column, typename Flags>
+size_t MarkLeftOf(const Column& x, const Column& width, float limit, Flags& keep) {
+    keep.resize(x.size());
+    size_t removed = 0;
+    for (size_t i = 0; i < x.size(); i++) {
+        keep[i] = x[i] + width[i] >= limit;
+        removed += !keep[i];
+    }
+    return removed;
+}
+
+// Drop the elements whose keep flag is 0, preserving the order of the rest.
+// Applied with the same flags to every column so the columns stay parallel.
+template <typename Column, typename Flags>
+void CompactColumn(Column& column, const Flags& keep) {
+    size_t count = 0;
+    for (size_t i = 0; i < column.size(); i++) {
+        if (keep[i]) {
+            column[count++] = column[i];
+        }
+    }
+    column.resize(count);
+}
+
+// Empty a column and free its storage (a no-op for arena storage, which
+// comes back when the arena is reset), keeping the column's allocator
+template <typename Column>
+void ReleaseColumn(Column& column) {
+    Column(column.get_allocator()).swap(column);
+}
+
+// Append the columns of a store to a saved-state image, in the order given
+template <typename... Columns>
+void WriteColumns(StateWriter& out, const Columns&... columns) {
+    (out.WriteColumn(columns), ...);
+}
+
+// Read back columns written by WriteColumns(), in the same order. Fails unless
+// they all come out the same length, so the store stays consistent.
+template <typename First, typename... Rest>
+bool ReadColumns(StateReader& in, First& first, Rest&... rest) {
+    if (!in.ReadColumn(first)) return false;
+    return ((in.ReadColumn(rest) && rest.size() == first.size()) && ...);
+}
+
+// True when every value of the columns lies within [-limit, limit], which
+// rules out NaN and infinity too
+template <typename... Columns>
+bool AllWithin(float limit, const Columns&... columns) {
+    auto within = [limit](float value) { return value >= -limit && value <= limit; };
+    return (std::all_of(columns.begin(), columns.end(), within) && ...);
+}
+
+template <typename... Columns>
+bool AllFinite(const Columns&... columns) {
+    return AllWithin(std::numeric_limits<float>::max(), columns...);
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "Types.h"
+#include <algorithm>
+#include <limits>
+
+// Swept (continuous) collision between axis-aligned boxes. A box is moved
+// along a straight line over one tick and tested against an obstacle for the
+// fraction of the motion at which they first touch, so a fast mover cannot
+// pass through a thin platform between two ticks however large the step.
+
+// Where a moving box first runs into an obstacle
+struct SweepHit {
+    float time;      // Fraction of the motion done at first contact, in [0, 1)
+    Vector2 normal;  // Side of the obstacle hit: (0, -1) top, (0, 1) bottom, (-1, 0) left, (1, 0) right
+};
+
+// Smallest box covering both start and end, i.e. the broad phase area of a motion
+inline Rectangle SweptBounds(const Rectangle& start, const Rectangle& end) {
+    float left = std::min(start.x, end.x);
+    float top = std::min(start.y, end.y);
+    float right = std::max(start.x + start.width, end.x + end.width);
+    float bottom = std::max(start.y + start.height, end.y + end.height);
+    return Rectangle(left, top, right - left, bottom - top);
+}
+
+// Move box by displacement against a resting obstacle (for a moving one, pass
+// the motion relative to it). Returns false when the box misses the obstacle,
+// only grazes it, ends the motion just touching it, or already overlaps it at
+// the start - overlaps are left to discrete resolution. Contacts on a corner
+// count as vertical so that landing wins over hitting a wall.
+inline bool SweepBox(const Rectangle& box, const Vector2& displacement, const Rectangle& obstacle, SweepHit& hit) {
+    const float infinity = std::numeric_limits<float>::infinity();
+    
+    // Fractions of the motion at which the boxes start and stop overlapping along one axis
+    auto axis = [infinity](float start, float size, float delta, float obstacleStart, float obstacleSize,
+                           float& entry, float& exit) {
+        float obstacleEnd = obstacleStart + obstacleSize;
+        if (delta == 0.0f) {
+            bool overlapping = start < obstacleEnd && start + size > obstacleStart;
+            entry = overlapping ? -infinity : infinity;
+            exit = infinity;
+        } else if (delta > 0.0f) {
+            entry = (obstacleStart - (start + size)) / delta;
+            exit = (obstacleEnd - start) / delta;
+        } else {
+            entry = (obstacleEnd - start) / delta;
+            exit = (obstacleStart - (start + size)) / delta;
+        }
+    };
+    
+    float entryX, exitX, entryY, exitY;
+    axis(box.x, box.width, displacement.x, obstacle.x, obstacle.width, entryX, exitX);
+    axis(box.y, box.height, displacement.y, obstacle.y, obstacle.height, entryY, exitY);
+    
+    float entry = std::max(entryX, entryY);
+    float exit = std::min(exitX, exitY);
+    if (entry >= exit || entry < 0.0f || entry >= 1.0f) {
+        return false;
+    }
+    
+    hit.time = entry;
+    if (entryY >= entryX) {
+        hit.normal = Vector2(0.0f, displacement.y > 0.0f ? -1.0f : 1.0f);
+    } else {
+        hit.normal = Vector2(displacement.x > 0.0f ? -1.0f : 1.0f, 0.0f);
+    }
+    return true;
+}
\ No newline at end of file
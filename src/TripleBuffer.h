@@ -0,0 +1,45 @@
+#pragma once
+#include <atomic>
+
+// Hands the newest of a stream of values from one producer thread to one
+// consumer thread without locks. Of three slots, the producer owns one (back),
+// the consumer owns one (front) and the third is in between. Publish() swaps
+// the filled back slot with the middle one; Acquire() swaps the middle one
+// with the front slot when something new was published since. Neither side
+// ever waits for the other, and a slow consumer simply skips values.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : m_back(0), m_middle(1), m_front(2) {}
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+    
+    // Producer: fill this slot, then publish it. It still holds whatever was
+    // written to it a few publishes ago.
+    T& GetBack() { return m_slots[m_back]; }
+    void Publish() {
+        unsigned previous = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel);
+        m_back = previous & INDEX_MASK;
+    }
+    
+    // Consumer: switch the front slot to the newest published value; returns
+    // false (and keeps the current one) when nothing new arrived
+    bool Acquire() {
+        if (!(m_middle.load(std::memory_order_relaxed) & FRESH)) {
+            return false;
+        }
+        unsigned previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = previous & INDEX_MASK;
+        return true;
+    }
+    const T& GetFront() const { return m_slots[m_front]; }
+    
+private:
+    static const unsigned INDEX_MASK = 3;
+    static const unsigned FRESH = 4;  // Set in m_middle while it holds an unread value
+    
+    T m_slots[3];
+    unsigned m_back;                 // Producer only
+    std::atomic<unsigned> m_middle;  // Slot index | FRESH
+    unsigned m_front;                // Consumer only
+};
\ No newline at end of file
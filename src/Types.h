@@ -0,0 +1,41 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+// Enhanced utility structs
+struct Vector2 {
+    float x, y;
+    Vector2(float x = 0, float y = 0) : x(x), y(y) {}
+    Vector2 operator+(const Vector2& other) const { return Vector2(x + other.x, y + other.y); }
+    Vector2 operator-(const Vector2& other) const { return Vector2(x - other.x, y - other.y); }
+    Vector2 operator*(float scalar) const { return Vector2(x * scalar, y * scalar); }
+    float Length() const { return std::sqrt(x*x + y*y); }
+    Vector2 Normalized() const { float len = Length(); return len > 0 ? Vector2(x/len, y/len) : Vector2(0,0); }
+};
+
+// Linear interpolation between the previous and current simulation state
+inline Vector2 Lerp(const Vector2& a, const Vector2& b, float t) {
+    return Vector2(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
+}
+
+struct Rectangle {
+    float x, y, width, height;
+    Rectangle(float x = 0, float y = 0, float w = 0, float h = 0) : x(x), y(y), width(w), height(h) {}
+    
+    bool Intersects(const Rectangle& other) const {
+        return x < other.x + other.width &&
+               x + width > other.x &&
+               y < other.y + other.height &&
+               y + height > other.y;
+    }
+    
+    Vector2 Center() const { return Vector2(x + width/2, y + height/2); }
+    
+    // Grown by margin on every side
+    Rectangle Expand(float margin) const { return Rectangle(x - margin, y - margin, width + 2*margin, height + 2*margin); }
+};
+
+struct Color {
+    std::uint8_t r, g, b, a;
+    Color(std::uint8_t r = 255, std::uint8_t g = 255, std::uint8_t b = 255, std::uint8_t a = 255) : r(r), g(g), b(b), a(a) {}
+};
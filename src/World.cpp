@@ -0,0 +1,935 @@
+#include "World.h"
+#include "ParticleSystem.h"
+#include "Profiler.h"
+#include "JobSystem.h"
+#include "StoreColumns.h"
+#include "Sweep.h"
+#include "StateStream.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+const float World::GRAVITY = 800.0f; // pixels per second squared
+const float World::STREAM_AHEAD = 1024.0f;
+const float World::STREAM_BEHIND = 1024.0f;
+const float World::ACTIVE_MARGIN = 256.0f;
+
+// Entities per job in the parallel update loops
+static const size_t UPDATE_BATCH_SIZE = 256;
+static const size_t COLLISION_BATCH_SIZE = 64;
+
+static const float PLAYER_SPAWN_X = 50.0f;
+static const float PLAYER_SPAWN_Y = World::HEIGHT - 100.0f;
+
+// Level 1 - balanced and achievable design
+static void BuildFirstLevel(LevelLayout& layout) {
+    layout.Reset(World::WIDTH, World::HEIGHT, Vector2(PLAYER_SPAWN_X, PLAYER_SPAWN_Y));
+    
+    // Ground platform
+    layout.platforms.push_back({0, World::HEIGHT - 50, World::WIDTH, 50});
+    
+    // Static platforms - arranged as stepping stones with reasonable gaps
+    layout.platforms.push_back({150, World::HEIGHT - 120, 120, 20});    // Low platform
+    layout.platforms.push_back({320, World::HEIGHT - 180, 120, 20});    // Medium platform
+    layout.platforms.push_back({500, World::HEIGHT - 240, 120, 20});    // Higher platform
+    layout.platforms.push_back({680, World::HEIGHT - 180, 120, 20});    // Back down
+    layout.platforms.push_back({850, World::HEIGHT - 140, 120, 20});    // Final platform
+    
+    // Additional platforms for easier navigation
+    layout.platforms.push_back({50, World::HEIGHT - 200, 80, 15});      // Helper platform
+    layout.platforms.push_back({400, World::HEIGHT - 120, 80, 15});     // Helper platform
+    layout.platforms.push_back({750, World::HEIGHT - 120, 80, 15});     // Helper platform
+    
+    // Moving platforms - positioned to help reach higher areas
+    layout.movingPlatforms.push_back({250, World::HEIGHT - 140, 60, 12, MovementType::HORIZONTAL, 40, 60});
+    layout.movingPlatforms.push_back({550, World::HEIGHT - 200, 60, 12, MovementType::VERTICAL, 30, 40});
+    layout.movingPlatforms.push_back({780, World::HEIGHT - 200, 50, 12, MovementType::HORIZONTAL, 35, 50});
+    
+    // Enemies - placed strategically but not blocking essential paths
+    layout.enemies.push_back({200, World::HEIGHT - 100});
+    layout.enemies.push_back({450, World::HEIGHT - 100});
+    layout.enemies.push_back({700, World::HEIGHT - 100});
+    layout.enemies.push_back({350, World::HEIGHT - 210});
+    
+    // Coins - placed near platforms and reachable with normal jumps
+    layout.coins.push_back({200, World::HEIGHT - 150});    // On first platform
+    layout.coins.push_back({370, World::HEIGHT - 210});    // On second platform  
+    layout.coins.push_back({550, World::HEIGHT - 270});    // On third platform
+    layout.coins.push_back({730, World::HEIGHT - 210});    // On fourth platform
+    layout.coins.push_back({900, World::HEIGHT - 170});    // On final platform
+    layout.coins.push_back({100, World::HEIGHT - 230});    // On helper platform
+    layout.coins.push_back({450, World::HEIGHT - 150});    // On helper platform
+    layout.coins.push_back({800, World::HEIGHT - 150});    // On helper platform
+    layout.coins.push_back({300, World::HEIGHT - 100});    // Ground level coin
+    layout.coins.push_back({600, World::HEIGHT - 100});    // Ground level coin
+    
+    // Power-ups - placed on accessible platforms
+    layout.powerUps.push_back({370, World::HEIGHT - 220, PowerUpType::SUPER_MARIO});    // On second platform
+    layout.powerUps.push_back({100, World::HEIGHT - 240, PowerUpType::SPEED_BOOST});    // On helper platform
+    layout.powerUps.push_back({900, World::HEIGHT - 180, PowerUpType::EXTRA_LIFE});     // On final platform
+}
+
+// Every later level: more platforms, moving platforms and a growing number of enemies
+static void BuildLevel(int level, LevelLayout& layout) {
+    layout.Reset(World::WIDTH, World::HEIGHT, Vector2(PLAYER_SPAWN_X, PLAYER_SPAWN_Y));
+    
+    layout.platforms.push_back({0, World::HEIGHT - 50, World::WIDTH, 50});
+    
+    // More complex platform layout
+    for (int i = 0; i < 8; i++) {
+        float x = 100 + i * 120;
+        float y = World::HEIGHT - 150 - (i % 3) * 100;
+        layout.platforms.push_back({x, y, 80, 15});
+    }
+    
+    // More moving platforms
+    for (int i = 0; i < 4; i++) {
+        MovementType type = static_cast<MovementType>(i % 3);
+        float x = 200 + i * 200;
+        float y = World::HEIGHT - 200 - i * 50;
+        layout.movingPlatforms.push_back({x, y, 60, 12, type, 50.0f + i * 20, 80});
+    }
+    
+    // More enemies
+    for (int i = 0; i < level + 3; i++) {
+        float x = 150 + i * 120;
+        float y = World::HEIGHT - 100;
+        layout.enemies.push_back({x, y});
+    }
+    
+    // More coins
+    for (int i = 0; i < 12; i++) {
+        float x = 80 + i * 80;
+        float y = World::HEIGHT - 120 - (i % 4) * 80;
+        layout.coins.push_back({x, y});
+    }
+    
+    // More power-ups
+    layout.powerUps.push_back({300, World::HEIGHT - 280, PowerUpType::SUPER_MARIO});
+    layout.powerUps.push_back({600, World::HEIGHT - 350, PowerUpType::SPEED_BOOST});
+    layout.powerUps.push_back({800, World::HEIGHT - 200, PowerUpType::EXTRA_LIFE});
+}
+
+World::World() 
+    : m_platforms(&m_arena), m_movingPlatforms(&m_arena), m_enemies(&m_arena), m_coins(&m_arena), m_powerUps(&m_arena), 
+      m_particleSystem(std::make_unique<ParticleSystem>()), 
+      m_emitters(&m_arena), m_emitterTimers(&m_arena), m_keepEmitters(&m_arena), 
+      m_width(WIDTH), m_height(HEIGHT), m_playerSpawn(PLAYER_SPAWN_X, PLAYER_SPAWN_Y), 
+      m_builtInLayout(WIDTH, HEIGHT, Vector2(PLAYER_SPAWN_X, PLAYER_SPAWN_Y)), m_levelFile(nullptr), m_source(), m_camera(WIDTH, HEIGHT), m_streamedChunks(0), m_releasedX(0.0f), 
+      m_streamedArea(0, 0, WIDTH, HEIGHT), m_releasedCollectedCoins(0), m_restreamPending(false), m_levelLoadCount(0), m_activeArea(0, 0, WIDTH, HEIGHT), m_score(0), m_lives(3), m_level(1), m_levelTime(0.0f), m_isGameOver(false), 
+      m_profiler(nullptr), m_jobs(nullptr) {
+}
+
+World::~World() = default;
+
+void World::Reset(int startLevel) {
+    m_customLayout.reset();
+    m_levelFile = nullptr;
+    BuildFirstLevel(m_builtInLayout);
+    Start(m_builtInLayout.playerSpawn);
+    LoadLayout(m_builtInLayout);
+    
+    // Skip ahead for sessions that start on a later level
+    while (m_level < startLevel) {
+        NextLevel();
+    }
+}
+
+void World::LoadScenario(const LevelLayout& layout) {
+    // Kept so that completing the scenario replays it instead of the built-in levels
+    m_levelFile = nullptr;
+    m_customLayout = std::make_unique<LevelLayout>(layout);
+    Start(layout.playerSpawn);
+    LoadLayout(*m_customLayout);
+}
+
+void World::LoadLevel(const LevelFile& file) {
+    m_customLayout.reset();
+    m_levelFile = &file;
+    Start(file.GetView().playerSpawn);
+    LoadView(file.GetView());
+}
+
+void World::Start(Vector2 playerSpawn) {
+    // Reset game state
+    m_score = 0;
+    m_lives = 3;
+    m_level = 1;
+    m_levelTime = 0.0f;
+    m_isGameOver = false;
+    
+    // Initialize player
+    m_player.emplace(playerSpawn.x, playerSpawn.y);
+}
+
+void World::SetSeed(std::uint32_t seed) {
+    m_particleSystem->Seed(seed);
+}
+
+void World::NextLevel() {
+    m_level++;
+    
+    if (m_levelFile) {
+        LoadView(m_levelFile->GetView());
+    } else if (m_customLayout) {
+        LoadLayout(*m_customLayout);
+    } else {
+        BuildLevel(m_level, m_builtInLayout);
+        LoadLayout(m_builtInLayout);
+    }
+    
+    // Reset player position
+    RespawnPlayer();
+    m_levelTime = 0.0f;
+}
+
+void World::LoadLayout(const LevelLayout& layout) {
+    // Built-in levels and scenarios are compiled to the level file format in memory
+    m_builtLevel.Build(layout);
+    LoadView(m_builtLevel.GetView());
+}
+
+void World::LoadView(const LevelView& view) {
+    SetSource(view);
+    m_camera.Reset(m_width);
+    m_streamedChunks = 0;
+    m_releasedX = 0.0f;
+    m_releasedCollectedCoins = 0;
+    m_restreamPending = false;
+    StreamChunks();
+}
+
+void World::SetSource(const LevelView& view) {
+    m_source = view;
+    m_width = view.width;
+    m_height = view.height;
+    m_playerSpawn = view.playerSpawn;
+    
+    // Tear down the current level: the stores let go of their columns and
+    // all of their memory is reclaimed at once
+    m_platforms.Clear();
+    m_movingPlatforms.Clear();
+    m_enemies.Clear();
+    m_coins.Clear();
+    m_powerUps.Clear();
+    ReleaseColumn(m_emitters);
+    ReleaseColumn(m_emitterTimers);
+    ReleaseColumn(m_keepEmitters);
+    m_arena.Reset();
+    ReserveResidentEntities(view);
+    m_levelLoadCount++;
+}
+
+// Most records of one type in any run of window consecutive chunks
+static size_t PeakInWindow(const std::uint32_t* chunkStart, size_t chunkCount, size_t window) {
+    size_t peak = 0;
+    for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+        size_t end = std::min(chunk + window, chunkCount);
+        peak = std::max<size_t>(peak, chunkStart[end] - chunkStart[chunk]);
+    }
+    return peak;
+}
+
+void World::ReserveResidentEntities(const LevelView& view) {
+    // Streaming keeps at most this many chunks resident: the view, the
+    // stretches ahead of and behind it and the chunks those end in. Sizing the
+    // columns for the busiest such window up front means they never grow, so
+    // the arena is not left holding their outgrown copies. (Wide platforms
+    // stay resident past their chunk; their columns may still grow a little.)
+    size_t window = static_cast<size_t>(std::ceil((WIDTH + STREAM_AHEAD + STREAM_BEHIND) / view.chunkWidth)) + 2;
+    m_platforms.Reserve(PeakInWindow(view.platforms.chunkStart, view.chunkCount, window));
+    m_movingPlatforms.Reserve(PeakInWindow(view.movingPlatforms.chunkStart, view.chunkCount, window));
+    m_enemies.Reserve(PeakInWindow(view.enemies.chunkStart, view.chunkCount, window));
+    m_coins.Reserve(PeakInWindow(view.coins.chunkStart, view.chunkCount, window));
+    m_powerUps.Reserve(PeakInWindow(view.powerUps.chunkStart, view.chunkCount, window));
+    
+    size_t emitters = PeakInWindow(view.emitters.chunkStart, view.chunkCount, window);
+    m_emitters.reserve(emitters);
+    m_emitterTimers.reserve(emitters);
+    m_keepEmitters.reserve(emitters);
+}
+
+void World::StreamChunks() {
+    Rectangle view = m_camera.GetView();
+    bool changed = false;
+    
+    // Stream in every chunk that starts before the right edge of the view plus STREAM_AHEAD
+    float loadUntil = view.x + view.width + STREAM_AHEAD;
+    while (m_streamedChunks < m_source.chunkCount && m_streamedChunks * m_source.chunkWidth < loadUntil) {
+        LoadChunk(m_streamedChunks++);
+        changed = true;
+    }
+    
+    // Release in whole chunks so compaction runs once per chunk scrolled, not every tick
+    float releaseX = std::floor((view.x - STREAM_BEHIND) / m_source.chunkWidth) * m_source.chunkWidth;
+    if (releaseX > m_releasedX) {
+        ReleaseLeftOf(releaseX);
+        m_releasedX = releaseX;
+        changed = true;
+    }
+    
+    if (changed) {
+        // The broad phase only covers the streamed-in stretch of the level
+        float streamedEnd = std::min(m_width, m_streamedChunks * m_source.chunkWidth);
+        m_streamedArea = Rectangle(m_releasedX, 0, streamedEnd - m_releasedX, m_height);
+        BuildStaticGrid();
+    }
+}
+
+void World::LoadChunk(size_t chunk) {
+    // Each type's records of one chunk are a contiguous slice of its columns
+    auto first = [chunk](const std::uint32_t* chunkStart) { return static_cast<size_t>(chunkStart[chunk]); };
+    auto count = [chunk](const std::uint32_t* chunkStart) { return static_cast<size_t>(chunkStart[chunk + 1] - chunkStart[chunk]); };
+    
+    const LevelView::Platforms& platforms = m_source.platforms;
+    size_t begin = first(platforms.chunkStart);
+    m_platforms.AddRange(count(platforms.chunkStart), platforms.x + begin, platforms.y + begin, 
+                         platforms.width + begin, platforms.height + begin);
+    
+    const LevelView::MovingPlatforms& movingPlatforms = m_source.movingPlatforms;
+    begin = first(movingPlatforms.chunkStart);
+    m_movingPlatforms.AddRange(count(movingPlatforms.chunkStart), movingPlatforms.x + begin, movingPlatforms.y + begin, 
+                               movingPlatforms.width + begin, movingPlatforms.height + begin, 
+                               movingPlatforms.type + begin, movingPlatforms.speed + begin, movingPlatforms.range + begin);
+    
+    const LevelView::Positions& enemies = m_source.enemies;
+    begin = first(enemies.chunkStart);
+    m_enemies.AddRange(count(enemies.chunkStart), enemies.x + begin, enemies.y + begin);
+    
+    const LevelView::Positions& coins = m_source.coins;
+    begin = first(coins.chunkStart);
+    m_coins.AddRange(count(coins.chunkStart), coins.x + begin, coins.y + begin);
+    
+    const LevelView::PowerUps& powerUps = m_source.powerUps;
+    begin = first(powerUps.chunkStart);
+    m_powerUps.AddRange(count(powerUps.chunkStart), powerUps.x + begin, powerUps.y + begin, powerUps.type + begin);
+    
+    // Stagger emitters by their interval so they don't all fire on the first tick
+    const LevelView::Emitters& emitters = m_source.emitters;
+    begin = first(emitters.chunkStart);
+    m_emitters.insert(m_emitters.end(), emitters.records + begin, emitters.records + begin + count(emitters.chunkStart));
+    for (size_t i = m_emitterTimers.size(); i < m_emitters.size(); i++) {
+        m_emitterTimers.push_back(m_emitters[i].interval);
+    }
+}
+
+void World::ReleaseLeftOf(float x) {
+    int collectedCoins = m_coins.CountCollected();
+    
+    m_platforms.RemoveLeftOf(x);
+    m_movingPlatforms.RemoveLeftOf(x);
+    m_enemies.RemoveLeftOf(x);
+    m_coins.RemoveLeftOf(x);
+    m_powerUps.RemoveLeftOf(x);
+    
+    // Coins scrolled out uncollected are forfeited; collected ones still count
+    m_releasedCollectedCoins += collectedCoins - m_coins.CountCollected();
+    
+    m_keepEmitters.resize(m_emitters.size());
+    for (size_t i = 0; i < m_emitters.size(); i++) {
+        m_keepEmitters[i] = m_emitters[i].x >= x;
+    }
+    CompactColumn(m_emitters, m_keepEmitters);
+    CompactColumn(m_emitterTimers, m_keepEmitters);
+}
+
+void World::Step(float deltaTime, const PlayerInput& input) {
+    if (m_isGameOver || !m_player) return;
+    
+    // Snapshot positions for render interpolation
+    m_player->StorePreviousState();
+    m_movingPlatforms.StorePreviousState();
+    m_enemies.StorePreviousState();
+    m_camera.StorePreviousState();
+    m_activeArea = m_camera.GetView().Expand(ACTIVE_MARGIN);
+    
+    // Handle player input once per tick
+    m_player->HandleInput(input);
+    
+    m_levelTime += deltaTime;
+    
+    UpdateEntities(deltaTime);
+    
+    // Update particle system
+    {
+        ProfileScope scope(m_profiler, ProfileZone::PARTICLE_UPDATE);
+        UpdateEmitters(deltaTime);
+        m_particleSystem->Update(deltaTime, m_jobs);
+    }
+    
+    // Platform collisions for player and enemies
+    Rectangle playerBounds = m_player->GetBounds();
+    ResolvePlatformCollisions(playerBounds, deltaTime);
+    
+    // Coin and power-up collection
+    CollectPickups(playerBounds);
+    
+    // Enemy-player collisions
+    ResolveEnemyCollisions(playerBounds);
+    
+    // Check for level completion (all coins collected once the whole level has streamed in)
+    bool allCoinsCollected = m_streamedChunks == m_source.chunkCount && 
+                             m_coins.CountCollected() == static_cast<int>(m_coins.Size());
+    
+    if (allCoinsCollected) {
+        NextLevel();
+        m_score += 1000 * m_level; // Bonus for completing level
+    }
+    
+    // Keep player in bounds; the camera never scrolls back, so neither can the player
+    Vector2 playerPos = m_player->GetPosition();
+    if (playerPos.x < m_camera.GetX()) {
+        m_player->SetPosition(Vector2(m_camera.GetX(), playerPos.y));
+    } else if (playerPos.x > m_width - 30) {
+        m_player->SetPosition(Vector2(m_width - 30, playerPos.y));
+    }
+    
+    // Check if player fell off screen
+    if (playerPos.y > m_height) {
+        m_lives--;
+        if (m_lives <= 0) {
+            m_isGameOver = true;
+        } else {
+            RespawnPlayer();
+        }
+    }
+    
+    // Add jump effect particles when jump keys are pressed and player is on ground
+    if (input.jumpPressed && m_player->IsOnGround()) {
+        m_particleSystem->CreateJumpEffect(Vector2(playerPos.x + 15, playerPos.y + 30));
+    }
+    
+    // A respawn behind the streamed-out part of the level starts it over
+    if (m_restreamPending) {
+        LoadView(m_source);
+    }
+    
+    // Scroll with the player and stream the level in around the view
+    m_camera.Follow(m_player->GetBounds());
+    StreamChunks();
+}
+
+void World::UpdateEntities(float deltaTime) {
+    ProfileScope scope(m_profiler, ProfileZone::ENTITY_UPDATE);
+    
+    // Update player
+    m_player->Update(deltaTime);
+    
+    // Update moving platforms
+    ParallelFor(m_jobs, m_movingPlatforms.Size(), UPDATE_BATCH_SIZE, [this, deltaTime](size_t, size_t begin, size_t end) {
+        m_movingPlatforms.Update(deltaTime, m_activeArea, begin, end);
+    });
+    RefreshMovingPlatformGrid();
+    
+    // Update enemies
+    ParallelFor(m_jobs, m_enemies.Size(), UPDATE_BATCH_SIZE, [this, deltaTime](size_t, size_t begin, size_t end) {
+        m_enemies.Update(deltaTime, m_collisionMap, m_width, m_activeArea, begin, end);
+    });
+    
+    // Update coins
+    ParallelFor(m_jobs, m_coins.Size(), UPDATE_BATCH_SIZE, [this, deltaTime](size_t, size_t begin, size_t end) {
+        m_coins.Update(deltaTime, begin, end);
+    });
+    
+    // Update power-ups
+    m_powerUps.Update(deltaTime);
+    RefreshPickupGrids();
+}
+
+void World::UpdateEmitters(float deltaTime) {
+    // Count down in parallel, collecting the emitters that fire per batch
+    m_firedEmitters.resize(JobSystem::CountBatches(m_emitters.size(), UPDATE_BATCH_SIZE));
+    ParallelFor(m_jobs, m_emitters.size(), UPDATE_BATCH_SIZE, [this, deltaTime](size_t batch, size_t begin, size_t end) {
+        std::vector<size_t>& fired = m_firedEmitters[batch];
+        fired.clear();
+        for (size_t i = begin; i < end; i++) {
+            m_emitterTimers[i] -= deltaTime;
+            if (m_emitterTimers[i] > 0) continue;
+            
+            m_emitterTimers[i] += m_emitters[i].interval;
+            fired.push_back(i);
+        }
+    });
+    
+    // Spawn in emitter order so the particle RNG is drawn the same way every run
+    for (const std::vector<size_t>& fired : m_firedEmitters) {
+        for (size_t i : fired) {
+            SpawnEmitterEffect(m_emitters[i]);
+        }
+    }
+}
+
+void World::SpawnEmitterEffect(const LevelLayout::EmitterRecord& emitter) {
+    Vector2 position(emitter.x, emitter.y);
+    switch (emitter.effect) {
+        case ParticleEffect::EXPLOSION: m_particleSystem->CreateExplosion(position); break;
+        case ParticleEffect::COIN: m_particleSystem->CreateCoinEffect(position); break;
+        case ParticleEffect::JUMP: m_particleSystem->CreateJumpEffect(position); break;
+        case ParticleEffect::POWER_UP: m_particleSystem->CreatePowerUpEffect(position); break;
+    }
+}
+
+void World::ResolvePlatformCollisions(const Rectangle& playerBounds, float deltaTime) {
+    ProfileScope scope(m_profiler, ProfileZone::PLATFORM_COLLISIONS);
+    
+    m_player->SetOnGround(false);
+    
+    // Landing on a moving platform carries the player along with it
+    auto ride = [this, deltaTime](const PlatformContact& contact, const Vector2& normal) {
+        if (contact.isMoving && normal.y < 0) {
+            Vector2 platformVel = m_movingPlatforms.GetVelocity(contact.index);
+            Vector2 newPos = m_player->GetPosition() + Vector2(platformVel.x * deltaTime, 0);
+            m_player->SetPosition(newPos);
+        }
+    };
+    
+    // Sweep the player's motion over the tick against the platforms near its
+    // path and stop at each in the order they are hit. Every contact is swept
+    // again with the motion that is left, as an earlier one may have cut it
+    // short (landing on one floor tile keeps the player off the next one's side).
+    Rectangle start = m_player->GetPreviousBounds();
+    FindPlatformContacts(start, playerBounds, m_queryResults, m_contacts);
+    for (const PlatformContact& contact : m_contacts) {
+        if (contact.time >= 1.0f) break;
+        
+        SweepHit hit;
+        if (SweepPlatform(contact, start, m_player->GetBounds(), hit)) {
+            m_player->ResolveCollision(GetPlatformBounds(contact), hit.normal);
+            ride(contact, hit.normal);
+        }
+    }
+    
+    // Overlaps the motion did not cause, such as a platform moving into the
+    // player or the player growing, are pushed out as before
+    for (const PlatformContact& contact : m_contacts) {
+        Rectangle platform = GetPlatformBounds(contact);
+        if (m_player->GetBounds().Intersects(platform)) {
+            ride(contact, m_player->ResolveCollision(platform));
+        }
+    }
+    
+    // Enemy platform collisions, the same way (sleeping enemies stand still).
+    // Each enemy only writes its own state, so batches run in parallel with
+    // their own scratch buffers.
+    size_t batchCount = JobSystem::CountBatches(m_enemies.Size(), COLLISION_BATCH_SIZE);
+    m_batchQueryResults.resize(batchCount);
+    m_batchContacts.resize(batchCount);
+    ParallelFor(m_jobs, m_enemies.Size(), COLLISION_BATCH_SIZE, [this](size_t batch, size_t begin, size_t end) {
+        std::vector<int>& queryResults = m_batchQueryResults[batch];
+        std::vector<PlatformContact>& contacts = m_batchContacts[batch];
+        for (int enemy = static_cast<int>(begin); enemy < static_cast<int>(end); enemy++) {
+            if (!m_enemies.IsAlive(enemy) || !m_enemies.IsAwake(enemy)) continue;
+            
+            Rectangle enemyStart = m_enemies.GetPreviousBounds(enemy);
+            FindPlatformContacts(enemyStart, m_enemies.GetBounds(enemy), queryResults, contacts);
+            for (const PlatformContact& contact : contacts) {
+                if (contact.time >= 1.0f) break;
+                
+                SweepHit hit;
+                if (SweepPlatform(contact, enemyStart, m_enemies.GetBounds(enemy), hit)) {
+                    m_enemies.ResolveCollision(enemy, GetPlatformBounds(contact), hit.normal);
+                }
+            }
+            
+            for (const PlatformContact& contact : contacts) {
+                Rectangle platform = GetPlatformBounds(contact);
+                if (m_enemies.GetBounds(enemy).Intersects(platform)) {
+                    m_enemies.ResolveCollision(enemy, platform);
+                }
+            }
+        }
+    });
+    RefreshEnemyGrid();
+}
+
+void World::FindPlatformContacts(const Rectangle& start, const Rectangle& end, std::vector<int>& queryResults, 
+                                 std::vector<PlatformContact>& contacts) const {
+    const float infinity = std::numeric_limits<float>::infinity();
+    Rectangle path = SweptBounds(start, end);
+    contacts.clear();
+    
+    auto add = [&](int index, bool isMoving) {
+        PlatformContact contact = {infinity, index, isMoving};
+        SweepHit hit;
+        if (SweepPlatform(contact, start, end, hit)) {
+            contact.time = hit.time;
+        }
+        contacts.push_back(contact);
+    };
+    
+    m_platformGrid.Query(path, queryResults);
+    for (int index : queryResults) {
+        add(index, false);
+    }
+    m_movingPlatformGrid.Query(path, queryResults);
+    for (int index : queryResults) {
+        add(index, true);
+    }
+    
+    // Ties in a fixed order so that the result never depends on the grid layout
+    std::sort(contacts.begin(), contacts.end(), [](const PlatformContact& a, const PlatformContact& b) {
+        if (a.time != b.time) return a.time < b.time;
+        if (a.isMoving != b.isMoving) return b.isMoving;
+        return a.index < b.index;
+    });
+}
+
+bool World::SweepPlatform(const PlatformContact& contact, const Rectangle& start, const Rectangle& end, 
+                          SweepHit& hit) const {
+    Vector2 motion(end.x - start.x, end.y - start.y);
+    if (!contact.isMoving) {
+        return SweepBox(start, motion, m_platforms.GetBounds(contact.index), hit);
+    }
+    
+    // Sweep against where the platform ended up, with the motion relative to the platform's
+    Rectangle platform = m_movingPlatforms.GetBounds(contact.index);
+    Rectangle previous = m_movingPlatforms.GetPreviousBounds(contact.index);
+    Vector2 platformMotion(platform.x - previous.x, platform.y - previous.y);
+    Rectangle relativeStart(start.x + platformMotion.x, start.y + platformMotion.y, start.width, start.height);
+    return SweepBox(relativeStart, motion - platformMotion, platform, hit);
+}
+
+Rectangle World::GetPlatformBounds(const PlatformContact& contact) const {
+    return contact.isMoving ? m_movingPlatforms.GetBounds(contact.index) : m_platforms.GetBounds(contact.index);
+}
+
+void World::CollectPickups(const Rectangle& playerBounds) {
+    ProfileScope scope(m_profiler, ProfileZone::PICKUPS);
+    
+    // Coin collection
+    m_coinGrid.Query(playerBounds, m_queryResults);
+    for (int index : m_queryResults) {
+        if (!m_coins.IsCollected(index)) {
+            m_coins.Collect(index);
+            m_score += m_coins.GetValue(index);
+            m_particleSystem->CreateCoinEffect(m_coins.GetBounds(index).Center());
+        }
+    }
+    
+    // Power-up collection
+    m_powerUpGrid.Query(playerBounds, m_queryResults);
+    for (int index : m_queryResults) {
+        if (!m_powerUps.IsCollected(index)) {
+            m_powerUps.Collect(index);
+            m_particleSystem->CreatePowerUpEffect(m_powerUps.GetBounds(index).Center());
+            
+            switch (m_powerUps.GetType(index)) {
+                case PowerUpType::SUPER_MARIO:
+                    m_player->SetPoweredUp(true);
+                    m_score += 200;
+                    break;
+                case PowerUpType::SPEED_BOOST:
+                    m_score += 150;
+                    break;
+                case PowerUpType::EXTRA_LIFE:
+                    m_lives++;
+                    m_score += 500;
+                    break;
+            }
+        }
+    }
+}
+
+void World::ResolveEnemyCollisions(const Rectangle& playerBounds) {
+    ProfileScope scope(m_profiler, ProfileZone::ENEMY_COLLISIONS);
+    
+    // Enemy-player collisions
+    m_enemyGrid.Query(playerBounds, m_queryResults);
+    for (int index : m_queryResults) {
+        if (m_enemies.IsAlive(index)) {
+            Rectangle enemyBounds = m_enemies.GetBounds(index);
+            Vector2 playerPos = m_player->GetPosition();
+            Vector2 enemyPos = Vector2(enemyBounds.x, enemyBounds.y);
+            
+            if (playerPos.y < enemyPos.y - 10 && !m_player->IsInvulnerable()) {
+                // Player stomped enemy
+                m_enemies.Kill(index);
+                m_score += 150;
+                m_particleSystem->CreateExplosion(enemyBounds.Center(), Color(139, 0, 0));
+                
+                // Small bounce
+                Vector2 bouncePos = Vector2(playerPos.x, playerPos.y - 5);
+                m_player->SetPosition(bouncePos);
+            } else if (!m_player->IsInvulnerable()) {
+                // Player hit by enemy
+                if (m_player->IsPoweredUp()) {
+                    m_player->SetPoweredUp(false);
+                    m_player->SetInvulnerable(2.0f);
+                } else {
+                    m_lives--;
+                    m_player->SetInvulnerable(2.0f);
+                    if (m_lives <= 0) {
+                        m_isGameOver = true;
+                    } else {
+                        // Reset position
+                        RespawnPlayer();
+                    }
+                }
+            }
+        }
+    }
+}
+
+std::uint64_t World::ComputeStateHash() const {
+    // FNV-1a over the exact bits of everything gameplay depends on
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    
+    mix(&m_score, sizeof(m_score));
+    mix(&m_lives, sizeof(m_lives));
+    mix(&m_level, sizeof(m_level));
+    mix(&m_levelTime, sizeof(m_levelTime));
+    if (m_player) {
+        Vector2 position = m_player->GetPosition();
+        mix(&position, sizeof(position));
+    }
+    for (int i = 0; i < static_cast<int>(m_enemies.Size()); i++) {
+        Rectangle bounds = m_enemies.GetBounds(i);
+        bool alive = m_enemies.IsAlive(i);
+        mix(&bounds, sizeof(bounds));
+        mix(&alive, sizeof(alive));
+    }
+    for (int i = 0; i < static_cast<int>(m_coins.Size()); i++) {
+        bool collected = m_coins.IsCollected(i);
+        mix(&collected, sizeof(collected));
+    }
+    return hash;
+}
+
+// Saved states start with this header. The level is identified by where it
+// came from plus its size and entity counts, which must match on loading.
+enum class LevelSource : std::uint32_t {
+    BUILT_IN,
+    SCENARIO,
+    FILE
+};
+
+struct StateHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t size;  // Of the whole image
+    LevelSource source;
+    std::int32_t level;  // Selects the layout of a built-in level
+    float width;
+    float height;
+    std::uint64_t counts[6];  // Platforms, moving platforms, enemies, coins, power-ups, emitters
+};
+
+static const char STATE_MAGIC[4] = {'M', 'S', 'A', 'V'};
+static const std::uint32_t STATE_VERSION = 3;
+
+static bool SameLevel(const StateHeader& header, const LevelView& view) {
+    const std::uint64_t counts[6] = {view.platforms.count, view.movingPlatforms.count, view.enemies.count,
+                                     view.coins.count, view.powerUps.count, view.emitters.count};
+    return header.width == view.width && header.height == view.height && std::equal(counts, counts + 6, header.counts);
+}
+
+static bool SameLevel(const StateHeader& header, const LevelLayout& layout) {
+    const std::uint64_t counts[6] = {layout.platforms.size(), layout.movingPlatforms.size(), layout.enemies.size(),
+                                     layout.coins.size(), layout.powerUps.size(), layout.emitters.size()};
+    return header.width == layout.width && header.height == layout.height && std::equal(counts, counts + 6, header.counts);
+}
+
+static bool WithinLevel(float value, float levelSize) {
+    return value >= 0.0f && value <= levelSize;
+}
+
+// SpawnEmitterEffect() switches on the effect, so reject values outside the
+// enum, and bursts are spawned at the emitter's position
+static bool ValidEmitters(const ArenaVector<LevelLayout::EmitterRecord>& emitters, const ArenaVector<float>& timers) {
+    for (const LevelLayout::EmitterRecord& emitter : emitters) {
+        if (static_cast<std::uint32_t>(emitter.effect) > static_cast<std::uint32_t>(ParticleEffect::POWER_UP) ||
+            !(std::abs(emitter.x) <= MAX_STATE_COORDINATE && std::abs(emitter.y) <= MAX_STATE_COORDINATE) ||
+            !std::isfinite(emitter.interval)) {
+            return false;
+        }
+    }
+    return AllFinite(timers);
+}
+
+void World::SaveState(std::vector<std::uint8_t>& image) const {
+    image.clear();
+    StateWriter out(image);
+    
+    StateHeader header = {};
+    std::copy(STATE_MAGIC, STATE_MAGIC + 4, header.magic);
+    header.version = STATE_VERSION;
+    header.source = m_levelFile ? LevelSource::FILE : m_customLayout ? LevelSource::SCENARIO : LevelSource::BUILT_IN;
+    header.level = m_level;
+    header.width = m_source.width;
+    header.height = m_source.height;
+    const std::uint64_t counts[6] = {m_source.platforms.count, m_source.movingPlatforms.count, m_source.enemies.count,
+                                     m_source.coins.count, m_source.powerUps.count, m_source.emitters.count};
+    std::copy(counts, counts + 6, header.counts);
+    out.Write(header);
+    
+    out.Write(m_score);
+    out.Write(m_lives);
+    out.Write(m_level);
+    out.Write(m_levelTime);
+    out.WriteFlag(m_isGameOver);
+    
+    // Streaming position; the broad phase is rebuilt from it on loading
+    m_camera.SaveState(out);
+    out.Write(static_cast<std::uint64_t>(m_streamedChunks));
+    out.Write(m_releasedX);
+    out.Write(m_streamedArea);
+    out.Write(m_releasedCollectedCoins);
+    out.WriteFlag(m_restreamPending);
+    
+    out.WriteFlag(m_player.has_value());
+    if (m_player) {
+        m_player->SaveState(out);
+    }
+    m_platforms.SaveState(out);
+    m_movingPlatforms.SaveState(out);
+    m_enemies.SaveState(out);
+    m_coins.SaveState(out);
+    m_powerUps.SaveState(out);
+    WriteColumns(out, m_emitters, m_emitterTimers);
+    m_particleSystem->SaveState(out);
+    
+    out.Patch(offsetof(StateHeader, size), static_cast<std::uint64_t>(image.size()));
+}
+
+bool World::LoadState(const std::vector<std::uint8_t>& image) {
+    StateReader in(image.data(), image.size());
+    StateHeader header;
+    if (!in.Read(header) || !std::equal(STATE_MAGIC, STATE_MAGIC + 4, header.magic) ||
+        header.version != STATE_VERSION || header.size != image.size()) {
+        return false;
+    }
+    
+    // Find the level the state was saved in, checking it before anything is changed
+    const LevelView* view = nullptr;
+    if (header.source == LevelSource::BUILT_IN) {
+        // Not while a scenario or level file is loaded, which the next restart would go back to
+        if (m_customLayout || m_levelFile || header.level < 1 || header.level > MAX_LEVEL) return false;
+        if (header.level == 1) {
+            BuildFirstLevel(m_builtInLayout);
+        } else {
+            BuildLevel(header.level, m_builtInLayout);
+        }
+        if (!SameLevel(header, m_builtInLayout)) return false;
+        
+        m_customLayout.reset();
+        m_levelFile = nullptr;
+        m_builtLevel.Build(m_builtInLayout);
+        view = &m_builtLevel.GetView();
+    } else if (header.source == LevelSource::SCENARIO) {
+        // The scenario is compiled into m_builtLevel whenever it is the one being played
+        if (!m_customLayout || !SameLevel(header, *m_customLayout)) return false;
+        view = &m_builtLevel.GetView();
+    } else if (header.source == LevelSource::FILE) {
+        if (!m_levelFile || !SameLevel(header, m_levelFile->GetView())) return false;
+        view = &m_levelFile->GetView();
+    } else {
+        return false;
+    }
+    
+    Random particleRandom = m_particleSystem->GetRandom();
+    SetSource(*view);
+    m_camera.Reset(m_width);
+    
+    // The grids and the collision map are built for the streamed area, so it
+    // and everything in it must lie within the level (the stores check their
+    // own columns) before BuildStaticGrid() can run
+    std::uint64_t streamedChunks = 0;
+    bool hasPlayer = false;
+    Player player(0.0f, 0.0f);
+    bool loaded = in.Read(m_score) && in.Read(m_lives) && in.Read(m_level) && m_level == header.level && 
+                  in.Read(m_levelTime) && std::isfinite(m_levelTime) && in.ReadFlag(m_isGameOver) && 
+                  m_camera.LoadState(in) && in.Read(streamedChunks) && streamedChunks <= m_source.chunkCount && 
+                  in.Read(m_releasedX) && WithinLevel(m_releasedX, m_width) && in.Read(m_streamedArea) && 
+                  WithinLevel(m_streamedArea.x, m_width) && WithinLevel(m_streamedArea.width, m_width) && 
+                  WithinLevel(m_streamedArea.y, m_height) && WithinLevel(m_streamedArea.height, m_height) && 
+                  in.Read(m_releasedCollectedCoins) && in.ReadFlag(m_restreamPending) &&
+                  in.ReadFlag(hasPlayer) && (!hasPlayer || player.LoadState(in)) && 
+                  m_platforms.LoadState(in) && m_movingPlatforms.LoadState(in) && m_enemies.LoadState(in) && 
+                  m_coins.LoadState(in) && m_powerUps.LoadState(in) && ReadColumns(in, m_emitters, m_emitterTimers) && 
+                  ValidEmitters(m_emitters, m_emitterTimers) && m_particleSystem->LoadState(in) && in.IsAtEnd();
+    if (!loaded) {
+        // Only an image damaged after its header gets here, with the level torn
+        // down already. Reload it without a player, so that nothing runs until
+        // the caller starts a game, and put the particle stream back.
+        Start(view->playerSpawn);
+        m_player.reset();
+        m_level = header.level;
+        LoadView(*view);
+        m_particleSystem->Clear();
+        m_particleSystem->SetRandom(particleRandom);
+        return false;
+    }
+    
+    if (hasPlayer) {
+        m_player = player;
+    } else {
+        m_player.reset();
+    }
+    m_streamedChunks = static_cast<size_t>(streamedChunks);
+    BuildStaticGrid();
+    return true;
+}
+
+void World::RespawnPlayer() {
+    m_player->SetPosition(m_playerSpawn);
+    m_player->StorePreviousState();
+    
+    // Entities may be mid-iteration here, so the level is reloaded at the end of the tick
+    m_restreamPending = m_releasedX > 0.0f;
+}
+
+void World::BuildStaticGrid() {
+    m_platformGrid.Begin(m_streamedArea);
+    for (int i = 0; i < static_cast<int>(m_platforms.Size()); i++) {
+        m_platformGrid.Insert(i, m_platforms.GetBounds(i));
+    }
+    m_platformGrid.Finish();
+    m_collisionMap.Build(m_streamedArea, m_platforms, m_platformGrid);
+    
+    // Dynamic grids must never refer to the previous level's entities
+    RefreshMovingPlatformGrid();
+    RefreshEnemyGrid();
+    RefreshPickupGrids();
+}
+
+void World::RefreshMovingPlatformGrid() {
+    m_movingPlatformGrid.Begin(m_streamedArea);
+    for (int i = 0; i < static_cast<int>(m_movingPlatforms.Size()); i++) {
+        m_movingPlatformGrid.Insert(i, m_movingPlatforms.GetBounds(i));
+    }
+    m_movingPlatformGrid.Finish();
+}
+
+void World::RefreshEnemyGrid() {
+    m_enemyGrid.Begin(m_streamedArea);
+    for (int i = 0; i < static_cast<int>(m_enemies.Size()); i++) {
+        if (m_enemies.IsAlive(i)) {
+            m_enemyGrid.Insert(i, m_enemies.GetBounds(i));
+        }
+    }
+    m_enemyGrid.Finish();
+}
+
+void World::RefreshPickupGrids() {
+    m_coinGrid.Begin(m_streamedArea);
+    for (int i = 0; i < static_cast<int>(m_coins.Size()); i++) {
+        if (!m_coins.IsCollected(i)) {
+            m_coinGrid.Insert(i, m_coins.GetBounds(i));
+        }
+    }
+    m_coinGrid.Finish();
+    
+    m_powerUpGrid.Begin(m_streamedArea);
+    for (int i = 0; i < static_cast<int>(m_powerUps.Size()); i++) {
+        if (!m_powerUps.IsCollected(i)) {
+            m_powerUpGrid.Insert(i, m_powerUps.GetBounds(i));
+        }
+    }
+    m_powerUpGrid.Finish();
+}
@@ -0,0 +1,220 @@
+#pragma once
+#include "Types.h"
+#include "Player.h"
+#include "Platform.h"
+#include "MovingPlatform.h"
+#include "Enemy.h"
+#include "Coin.h"
+#include "PowerUp.h"
+#include "SpatialGrid.h"
+#include "CollisionMap.h"
+#include "LevelLayout.h"
+#include "LevelFile.h"
+#include "Camera.h"
+#include "LevelArena.h"
+#include <vector>
+#include <memory>
+#include <optional>
+#include <cstdint>
+
+// Forward declarations
+class ParticleSystem;
+class Profiler;
+class JobSystem;
+struct SweepHit;
+
+// The complete game simulation: entities, collisions, scoring and level setup.
+// Has no dependency on SDL so it can run headless (tests, CI, benchmarks).
+class World {
+public:
+    World();
+    ~World();
+    
+    // Game state management
+    void Reset(int startLevel = 1);
+    void NextLevel();
+    
+    // Start a new game on a custom layout (e.g. a generated stress scenario)
+    // instead of the built-in levels; completing it starts it over
+    void LoadScenario(const LevelLayout& layout);
+    
+    // Same for a compiled level file, which must stay open while it is played
+    void LoadLevel(const LevelFile& file);
+    
+    // Seed every source of randomness so a session can be replayed exactly
+    void SetSeed(std::uint32_t seed);
+    
+    // Advance the simulation by one fixed tick
+    void Step(float deltaTime, const PlayerInput& input);
+    
+    bool IsGameOver() const { return m_isGameOver; }
+    
+    // Optional: time the Step() sub-phases into this profiler (nullptr disables)
+    void SetProfiler(Profiler* profiler) { m_profiler = profiler; }
+    
+    // Optional: split the per-entity loops of Step() across these threads
+    // (nullptr runs them serially). The results are identical either way.
+    void SetJobSystem(JobSystem* jobs) { m_jobs = jobs; }
+    
+    // Accessors used by the renderer
+    const Player* GetPlayer() const { return m_player ? &*m_player : nullptr; }
+    const PlatformStore& GetPlatforms() const { return m_platforms; }
+    const MovingPlatformStore& GetMovingPlatforms() const { return m_movingPlatforms; }
+    const EnemyStore& GetEnemies() const { return m_enemies; }
+    const CoinStore& GetCoins() const { return m_coins; }
+    const PowerUpStore& GetPowerUps() const { return m_powerUps; }
+    ParticleSystem& GetParticleSystem() { return *m_particleSystem; }
+    const ParticleSystem& GetParticleSystem() const { return *m_particleSystem; }
+    
+    int GetScore() const { return m_score; }
+    int GetLives() const { return m_lives; }
+    int GetLevel() const { return m_level; }
+    float GetLevelTime() const { return m_levelTime; }
+    float GetWidth() const { return m_width; }
+    // Changes whenever a level is (re)loaded, i.e. whenever the static platforms may have
+    std::uint32_t GetLevelLoadCount() const { return m_levelLoadCount; }
+    const Camera& GetCamera() const { return m_camera; }
+    
+    // Coins of the whole level, including those already streamed out
+    int GetCoinCount() const { return static_cast<int>(m_source.coins.count); }
+    int CountCollectedCoins() const { return m_releasedCollectedCoins + m_coins.CountCollected(); }
+    
+    // Hash of the gameplay state, for checking that two runs ended up identical
+    std::uint64_t ComputeStateHash() const;
+    
+    // Write the complete simulation state into image, replacing its contents.
+    // The level being played is identified rather than copied, so this is one
+    // copy per entity column, cheap enough to do every tick.
+    void SaveState(std::vector<std::uint8_t>& image) const;
+    // Continue from an image written by SaveState(). Built-in levels are
+    // rebuilt as needed; a scenario or level file image needs that scenario or
+    // file loaded already, and a built-in level image needs neither. Returns
+    // false and leaves the world as it was when the image is not a saved state
+    // of this build or of the loaded level; one damaged past its header leaves
+    // the saved level reloaded without a player, to be started over.
+    bool LoadState(const std::vector<std::uint8_t>& image);
+    
+    // Holds the entity storage of the current level
+    const LevelArena& GetArena() const { return m_arena; }
+    
+    // Size of the built-in levels (one screen); custom layouts may be wider
+    static const int WIDTH = 1000;
+    static const int HEIGHT = 700;
+    static const float GRAVITY;
+    
+    // Highest level a session can start on or be continued from; every
+    // built-in level has one more enemy than the one before
+    static const int MAX_LEVEL = 1000;
+    
+    // Chunks are streamed in this far ahead of the view and released this far behind it
+    static const float STREAM_AHEAD;
+    static const float STREAM_BEHIND;
+    
+    // Entities within this distance of the view are updated every tick; the
+    // rest of the streamed-in level sleeps until the camera comes closer
+    static const float ACTIVE_MARGIN;
+    
+private:
+    void RespawnPlayer();
+    void Start(Vector2 playerSpawn);
+    void LoadLayout(const LevelLayout& layout);
+    void LoadView(const LevelView& view);
+    void SetSource(const LevelView& view);
+    void ReserveResidentEntities(const LevelView& view);
+    
+    // Chunk streaming
+    void StreamChunks();
+    void LoadChunk(size_t chunk);
+    void ReleaseLeftOf(float x);
+    
+    // Step() phases
+    void UpdateEntities(float deltaTime);
+    void UpdateEmitters(float deltaTime);
+    void SpawnEmitterEffect(const LevelLayout::EmitterRecord& emitter);
+    void ResolvePlatformCollisions(const Rectangle& playerBounds, float deltaTime);
+    void CollectPickups(const Rectangle& playerBounds);
+    void ResolveEnemyCollisions(const Rectangle& playerBounds);
+    
+    // A platform near the path of a box moving this tick, and the fraction of
+    // the motion at which the box first runs into it (infinity if it doesn't)
+    struct PlatformContact {
+        float time;
+        int index;
+        bool isMoving;  // Index into m_movingPlatforms rather than m_platforms
+    };
+    // Collect the platforms near the motion from start to end, earliest contact first
+    void FindPlatformContacts(const Rectangle& start, const Rectangle& end, std::vector<int>& queryResults, 
+                              std::vector<PlatformContact>& contacts) const;
+    // Sweep the motion from start to end against a contact's platform, taking
+    // a moving platform's own motion over the tick into account
+    bool SweepPlatform(const PlatformContact& contact, const Rectangle& start, const Rectangle& end, SweepHit& hit) const;
+    Rectangle GetPlatformBounds(const PlatformContact& contact) const;
+    
+    // Broad phase maintenance
+    void BuildStaticGrid();
+    void RefreshMovingPlatformGrid();
+    void RefreshEnemyGrid();
+    void RefreshPickupGrids();
+    
+    // Storage of everything below that belongs to the current level; declared
+    // first so it outlives the stores. Loading a level releases the stores'
+    // columns and resets it, so level teardown does not depend on entity count.
+    LevelArena m_arena;
+    
+    // Game objects - one structure-of-arrays store per entity archetype
+    std::optional<Player> m_player;
+    PlatformStore m_platforms;
+    MovingPlatformStore m_movingPlatforms;
+    EnemyStore m_enemies;
+    CoinStore m_coins;
+    PowerUpStore m_powerUps;
+    std::unique_ptr<ParticleSystem> m_particleSystem;
+    ArenaVector<LevelLayout::EmitterRecord> m_emitters;
+    ArenaVector<float> m_emitterTimers;  // Seconds until each emitter's next burst
+    ArenaVector<std::uint8_t> m_keepEmitters;  // ReleaseLeftOf() scratch
+    
+    // Current level bounds and spawn point
+    float m_width;
+    float m_height;
+    Vector2 m_playerSpawn;
+    std::unique_ptr<LevelLayout> m_customLayout;  // Set by LoadScenario()
+    LevelLayout m_builtInLayout;                  // Built-in level being loaded, reused for every level
+    const LevelFile* m_levelFile;                 // Set by LoadLevel()
+    LevelFile m_builtLevel;                       // Layouts compiled in memory
+    
+    // The level is streamed from m_source in chunks as the camera scrolls
+    LevelView m_source;
+    Camera m_camera;
+    size_t m_streamedChunks;       // Chunks [0, m_streamedChunks) have been loaded
+    float m_releasedX;             // Entities left of this have been released
+    Rectangle m_streamedArea;      // Streamed-in part of the level, covered by the broad phase
+    int m_releasedCollectedCoins;
+    bool m_restreamPending;        // Player respawned at the start of a partly released level
+    std::uint32_t m_levelLoadCount;
+    Rectangle m_activeArea;        // View plus ACTIVE_MARGIN at the start of the tick
+    
+    // Broad phase: static platforms are bucketed once per level, everything else every tick
+    SpatialGrid m_platformGrid;
+    SpatialGrid m_movingPlatformGrid;
+    SpatialGrid m_enemyGrid;
+    SpatialGrid m_coinGrid;
+    SpatialGrid m_powerUpGrid;
+    CollisionMap m_collisionMap;  // Static platforms again, for the enemies' ground probes
+    std::vector<int> m_queryResults;
+    std::vector<PlatformContact> m_contacts;
+    
+    // Per-batch scratch for the parallel loops, merged in batch order
+    std::vector<std::vector<int>> m_batchQueryResults;
+    std::vector<std::vector<PlatformContact>> m_batchContacts;
+    std::vector<std::vector<size_t>> m_firedEmitters;
+    
+    // Game state
+    int m_score;
+    int m_lives;
+    int m_level;
+    float m_levelTime;
+    bool m_isGameOver;
+    
+    Profiler* m_profiler;
+    JobSystem* m_jobs;
+};
@@ -0,0 +1,30 @@
+#include "WorldSnapshot.h"
+#include "World.h"
+
+WorldSnapshot::WorldSnapshot() 
+    : camera(World::WIDTH, World::HEIGHT), score(0), lives(0), level(1), coinCount(0), collectedCoins(0), 
+      width(World::WIDTH), levelLoadCount(0) {
+}
+
+void WorldSnapshot::Capture(const World& world) {
+    camera = world.GetCamera();
+    platforms = world.GetPlatforms();
+    movingPlatforms = world.GetMovingPlatforms();
+    enemies = world.GetEnemies();
+    coins = world.GetCoins();
+    powerUps = world.GetPowerUps();
+    if (world.GetPlayer()) {
+        player = *world.GetPlayer();
+    } else {
+        player.reset();
+    }
+    particles.CopyRenderState(world.GetParticleSystem());
+    
+    score = world.GetScore();
+    lives = world.GetLives();
+    level = world.GetLevel();
+    coinCount = world.GetCoinCount();
+    collectedCoins = world.CountCollectedCoins();
+    width = world.GetWidth();
+    levelLoadCount = world.GetLevelLoadCount();
+}
\ No newline at end of file
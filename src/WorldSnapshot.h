@@ -0,0 +1,42 @@
+#pragma once
+#include "Player.h"
+#include "Platform.h"
+#include "MovingPlatform.h"
+#include "Enemy.h"
+#include "Coin.h"
+#include "PowerUp.h"
+#include "ParticleSystem.h"
+#include "Camera.h"
+#include <optional>
+#include <cstdint>
+
+class World;
+
+// Copy of everything the renderer reads from a World: the camera, every
+// streamed-in entity with its previous and current transform and animation
+// timers, the live particles and the HUD values. Taken after a tick so a
+// frame can be drawn from it on another thread while the next tick runs.
+// Capturing into a snapshot that was used before reuses its storage, so once
+// the entity counts have peaked it allocates nothing.
+struct WorldSnapshot {
+    WorldSnapshot();
+    
+    void Capture(const World& world);
+    
+    Camera camera;
+    PlatformStore platforms;
+    MovingPlatformStore movingPlatforms;
+    EnemyStore enemies;
+    CoinStore coins;
+    PowerUpStore powerUps;
+    std::optional<Player> player;
+    ParticleSystem particles;
+    
+    int score;
+    int lives;
+    int level;
+    int coinCount;
+    int collectedCoins;
+    float width;
+    std::uint32_t levelLoadCount;
+};
\ No newline at end of file
@@ -1,11 +1,240 @@
 #include "Game.h"
+#include "World.h"
+#include "Profiler.h"
+#include "InputRecording.h"
+#include "ScenarioGenerator.h"
+#include "LevelFile.h"
+#include "JobSystem.h"
 #include <iostream>
+#include <string>
+#include <cstdlib>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+// Step the simulation as fast as possible without a window, renderer or fonts.
+// With a replay the recorded inputs drive the player; otherwise it stands idle.
+// A scenario or level file replaces the built-in levels.
+static int RunHeadless(long long ticks, int tickRate, bool profile, const InputRecording* replay,
+                       const LevelLayout* scenario, const LevelFile* level, JobSystem* jobs) {
+    if (replay) {
+        ticks = static_cast<long long>(replay->GetTickCount());
+        tickRate = replay->GetTickRate();
+    }
+    
+    const float deltaTime = 1.0f / static_cast<float>(tickRate);
+    World world;
+    world.SetJobSystem(jobs);
+    double levelLoadMilliseconds = 0.0;
+    if (replay) {
+        world.SetSeed(replay->GetSeed());
+        world.Reset(replay->GetStartLevel());
+    } else {
+        auto loadStart = std::chrono::steady_clock::now();
+        if (scenario) {
+            world.LoadScenario(*scenario);
+        } else if (level) {
+            world.LoadLevel(*level);
+        } else {
+            world.Reset();
+        }
+        auto loadEnd = std::chrono::steady_clock::now();
+        levelLoadMilliseconds = std::chrono::duration<double, std::milli>(loadEnd - loadStart).count();
+    }
+    
+    // Restarts go back to this state, as they do in the game
+    std::vector<std::uint8_t> startState;
+    world.SaveState(startState);
+    
+    // Each tick is one profiler frame; the history covers the last 10000 ticks
+    Profiler profiler(10000);
+    if (profile) {
+        world.SetProfiler(&profiler);
+    }
+    
+    PlayerInput input;
+    int gamesPlayed = 1;
+    
+    auto start = std::chrono::steady_clock::now();
+    for (long long tick = 0; tick < ticks; tick++) {
+        if (replay) {
+            if (replay->IsRestart(tick)) {
+                world.LoadState(startState);
+                gamesPlayed++;
+            }
+            input = replay->GetInput(tick);
+        }
+        
+        if (profile) {
+            profiler.BeginFrame();
+        }
+        
+        {
+            ProfileScope scope(profile ? &profiler : nullptr, ProfileZone::UPDATE);
+            world.Step(deltaTime, input);
+        }
+        
+        if (profile) {
+            profiler.EndFrame();
+        }
+        
+        // Keep the workload going across game overs (a replay ends with its session)
+        if (world.IsGameOver() && !replay) {
+            world.LoadState(startState);
+            gamesPlayed++;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    
+    double wallSeconds = std::chrono::duration<double>(end - start).count();
+    double simulatedSeconds = ticks * static_cast<double>(deltaTime);
+    
+    std::cout << "Headless run: " << ticks << " ticks at " << tickRate << " Hz"
+              << (replay ? " (replay)" : "") << std::endl;
+    if (scenario) {
+        std::cout << "  Scenario:       " << scenario->CountEntities() << " entities, " 
+                  << scenario->width << " px wide" << std::endl;
+    }
+    if (level) {
+        std::cout << "  Level file:     " << level->GetView().CountEntities() << " entities, " 
+                  << level->GetView().width << " px wide, loaded in " << levelLoadMilliseconds << " ms" << std::endl;
+    }
+    std::cout << "  Threads:        " << jobs->GetWorkerCount() + 1 << std::endl;
+    std::cout << "  Simulated time: " << simulatedSeconds << " s" << std::endl;
+    std::cout << "  Wall time:      " << wallSeconds << " s" << std::endl;
+    if (wallSeconds > 0) {
+        std::cout << "  Speed:          " << simulatedSeconds / wallSeconds << "x real time ("
+                  << ticks / wallSeconds << " ticks/s)" << std::endl;
+    }
+    std::cout << "  Games played:   " << gamesPlayed << std::endl;
+    // Levels are loaded into the arena; its heap block count stays flat once it has grown to fit them
+    const LevelArena& arena = world.GetArena();
+    std::cout << "  Level arena:    " << arena.GetAllocationCount() << " allocations, " << arena.GetBytesUsed() 
+              << " bytes of " << arena.GetCapacity() / 1024 << " KiB; " << arena.GetHeapAllocationCount() 
+              << " heap blocks in total" << std::endl;
+    std::cout << "  Final state:    level " << world.GetLevel() << ", score " << world.GetScore()
+              << ", lives " << world.GetLives() << std::endl;
+    std::cout << "  State hash:     " << std::hex << world.ComputeStateHash() << std::dec << std::endl;
+    
+    if (profile) {
+        std::cout << std::endl;
+        profiler.PrintSummary(std::cout);
+    }
+    return 0;
+}
 
 int main(int argc, char* argv[]) {
-    (void)argc; // Suppress unused parameter warning
-    (void)argv;
+    bool headless = false;
+    bool profile = false;
+    long long headlessTicks = 3600;
+    int tickRate = 60;
+    std::string recordPath;
+    std::string replayPath;
+    std::string scenarioSpecification;
+    std::string levelPath;
+    std::string savePath;
+    int threadCount = JobSystem::DefaultWorkerCount() + 1;
+    bool serial = false;
+    
+    // Optional command line: --tick-rate <hz>, --headless [--ticks <n>] [--profile],
+    // --record <file>, --replay <file>, --scenario <key=value,...>, --level <file.mlvl>,
+    // --threads <n> (including the main thread), --serial (tick and render in turn on the main thread),
+    // --save <file> (continue the game saved there and save it there on quitting)
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--tick-rate" && i + 1 < argc) {
+            tickRate = std::atoi(argv[++i]);
+        } else if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--ticks" && i + 1 < argc) {
+            headlessTicks = std::atoll(argv[++i]);
+        } else if (arg == "--profile") {
+            profile = true;
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (arg == "--scenario" && i + 1 < argc) {
+            scenarioSpecification = argv[++i];
+        } else if (arg == "--level" && i + 1 < argc) {
+            levelPath = argv[++i];
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threadCount = std::atoi(argv[++i]);
+        } else if (arg == "--serial") {
+            serial = true;
+        } else if (arg == "--save" && i + 1 < argc) {
+            savePath = argv[++i];
+        }
+    }
+    
+    if (tickRate <= 0) {
+        std::cerr << "Invalid tick rate: " << tickRate << std::endl;
+        return -1;
+    }
+    if (threadCount <= 0) {
+        std::cerr << "Invalid thread count: " << threadCount << std::endl;
+        return -1;
+    }
+    JobSystem jobs(threadCount - 1);
+    
+    // Recordings only describe the built-in levels
+    std::unique_ptr<LevelLayout> scenario;
+    if (!scenarioSpecification.empty()) {
+        ScenarioParameters parameters;
+        if (!parameters.Parse(scenarioSpecification)) {
+            std::cerr << "Invalid scenario: " << scenarioSpecification << std::endl;
+            return -1;
+        }
+        if (!recordPath.empty() || !replayPath.empty()) {
+            std::cerr << "--scenario cannot be combined with --record or --replay" << std::endl;
+            return -1;
+        }
+        scenario = std::make_unique<LevelLayout>(ScenarioGenerator::Generate(parameters));
+    }
+    
+    LevelFile level;
+    if (!levelPath.empty()) {
+        if (!recordPath.empty() || !replayPath.empty() || scenario) {
+            std::cerr << "--level cannot be combined with --record, --replay or --scenario" << std::endl;
+            return -1;
+        }
+        if (!level.Open(levelPath)) {
+            std::cerr << "Could not load level file: " << levelPath << std::endl;
+            return -1;
+        }
+    }
+    
+    // A recording has to start at the beginning of a game
+    if (!savePath.empty() && (!recordPath.empty() || !replayPath.empty())) {
+        std::cerr << "--save cannot be combined with --record or --replay" << std::endl;
+        return -1;
+    }
+    
+    InputRecording replay;
+    if (!replayPath.empty() && !replay.Load(replayPath)) {
+        std::cerr << "Could not load input recording: " << replayPath << std::endl;
+        return -1;
+    }
+    
+    if (headless) {
+        return RunHeadless(headlessTicks, tickRate, profile, replayPath.empty() ? nullptr : &replay, scenario.get(),
+                           level.IsOpen() ? &level : nullptr, &jobs);
+    }
     
     Game game;
+    game.SetTickRate(tickRate);
+    game.SetJobSystem(&jobs);
+    game.SetSimulationThread(!serial);
+    if (!replayPath.empty()) {
+        game.SetReplay(replay);
+    } else if (!recordPath.empty()) {
+        game.SetRecordPath(recordPath);
+    } else if (scenario) {
+        game.SetScenario(*scenario);
+    } else if (level.IsOpen()) {
+        game.SetLevelFile(&level);
+    }
+    game.SetSavePath(savePath);
     
     if (!game.Initialize()) {
         std::cerr << "Failed to initialize game!" << std::endl;
@@ -16,4 +245,4 @@ int main(int argc, char* argv[]) {
     game.Shutdown();
     
     return 0;
-} 
\ No newline at end of file
+}
@@ -0,0 +1,154 @@
+#include "LevelFile.h"
+#include "ScenarioGenerator.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Compiles a text level description into the binary .mlvl format that
+// `mario_game --level` memory-maps. One entity per line, '#' starts a comment:
+//
+//   size <width> <height>
+//   spawn <x> <y>
+//   platform <x> <y> <width> <height>
+//   moving <x> <y> <width> <height> horizontal|vertical|circular <speed> <range>
+//   enemy <x> <y>
+//   coin <x> <y>
+//   powerup <x> <y> super|speed|life
+//   emitter <x> <y> explosion|coin|jump|powerup <interval>
+//
+// Usage: level_compiler <level.txt> <level.mlvl>
+//        level_compiler --scenario <key=value,...> <level.mlvl>
+
+static bool ParseMovementType(const std::string& name, MovementType& type) {
+    if (name == "horizontal") type = MovementType::HORIZONTAL;
+    else if (name == "vertical") type = MovementType::VERTICAL;
+    else if (name == "circular") type = MovementType::CIRCULAR;
+    else return false;
+    return true;
+}
+
+static bool ParsePowerUpType(const std::string& name, PowerUpType& type) {
+    if (name == "super") type = PowerUpType::SUPER_MARIO;
+    else if (name == "speed") type = PowerUpType::SPEED_BOOST;
+    else if (name == "life") type = PowerUpType::EXTRA_LIFE;
+    else return false;
+    return true;
+}
+
+static bool ParseParticleEffect(const std::string& name, ParticleEffect& effect) {
+    if (name == "explosion") effect = ParticleEffect::EXPLOSION;
+    else if (name == "coin") effect = ParticleEffect::COIN;
+    else if (name == "jump") effect = ParticleEffect::JUMP;
+    else if (name == "powerup") effect = ParticleEffect::POWER_UP;
+    else return false;
+    return true;
+}
+
+// Parse one line into layout; returns false on unknown keywords or bad values
+static bool ParseLine(const std::string& line, LevelLayout& layout) {
+    std::istringstream words(line.substr(0, line.find('#')));
+    std::string keyword;
+    if (!(words >> keyword)) {
+        return true;  // Blank or comment-only line
+    }
+    
+    std::string name;
+    bool parsed = false;
+    if (keyword == "size") {
+        parsed = static_cast<bool>(words >> layout.width >> layout.height) && layout.width > 0 && layout.height > 0;
+    } else if (keyword == "spawn") {
+        parsed = static_cast<bool>(words >> layout.playerSpawn.x >> layout.playerSpawn.y);
+    } else if (keyword == "platform") {
+        LevelLayout::PlatformRecord platform;
+        parsed = static_cast<bool>(words >> platform.x >> platform.y >> platform.width >> platform.height);
+        layout.platforms.push_back(platform);
+    } else if (keyword == "moving") {
+        LevelLayout::MovingPlatformRecord platform;
+        parsed = words >> platform.x >> platform.y >> platform.width >> platform.height >> name &&
+                 ParseMovementType(name, platform.type) && words >> platform.speed >> platform.range;
+        layout.movingPlatforms.push_back(platform);
+    } else if (keyword == "enemy") {
+        LevelLayout::EnemyRecord enemy;
+        parsed = static_cast<bool>(words >> enemy.x >> enemy.y);
+        layout.enemies.push_back(enemy);
+    } else if (keyword == "coin") {
+        LevelLayout::CoinRecord coin;
+        parsed = static_cast<bool>(words >> coin.x >> coin.y);
+        layout.coins.push_back(coin);
+    } else if (keyword == "powerup") {
+        LevelLayout::PowerUpRecord powerUp;
+        parsed = words >> powerUp.x >> powerUp.y >> name && ParsePowerUpType(name, powerUp.type);
+        layout.powerUps.push_back(powerUp);
+    } else if (keyword == "emitter") {
+        LevelLayout::EmitterRecord emitter;
+        parsed = words >> emitter.x >> emitter.y >> name && ParseParticleEffect(name, emitter.effect) &&
+                 words >> emitter.interval && emitter.interval > 0;
+        layout.emitters.push_back(emitter);
+    }
+    
+    // Nothing may follow the last value
+    std::string rest;
+    return parsed && !(words >> rest);
+}
+
+static bool ParseLevelText(const std::string& path, LevelLayout& layout) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Could not open " << path << std::endl;
+        return false;
+    }
+    
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (!ParseLine(line, layout)) {
+            std::cerr << path << ":" << lineNumber << ": invalid line: " << line << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3 && !(argc == 4 && std::string(argv[1]) == "--scenario")) {
+        std::cerr << "Usage: " << argv[0] << " <level.txt> <level.mlvl>" << std::endl;
+        std::cerr << "       " << argv[0] << " --scenario <key=value,...> <level.mlvl>" << std::endl;
+        return 1;
+    }
+    
+    // Same defaults as the built-in levels
+    LevelLayout layout(1000.0f, 700.0f, Vector2(50.0f, 600.0f));
+    if (argc == 4) {
+        ScenarioParameters parameters;
+        if (!parameters.Parse(argv[2])) {
+            std::cerr << "Invalid scenario: " << argv[2] << std::endl;
+            return 1;
+        }
+        layout = ScenarioGenerator::Generate(parameters);
+    } else if (!ParseLevelText(argv[1], layout)) {
+        return 1;
+    }
+    
+    std::string outputPath = argv[argc - 1];
+    if (!LevelFile::Write(outputPath, layout)) {
+        std::cerr << "Could not write " << outputPath << std::endl;
+        return 1;
+    }
+    
+    // Map the result once to check it and report the load cost
+    auto start = std::chrono::steady_clock::now();
+    LevelFile level;
+    bool opened = level.Open(outputPath);
+    double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (!opened) {
+        std::cerr << "Wrote " << outputPath << " but could not map it back" << std::endl;
+        return 1;
+    }
+    
+    std::cout << "Wrote " << outputPath << ": " << layout.CountEntities() << " entities, "
+              << layout.width << "x" << layout.height << " px (mapped in " << milliseconds << " ms)" << std::endl;
+    return 0;
+}
\ No newline at end of file